@@ -35,6 +35,15 @@ typedef void (* rmw_uros_continous_serialization_size)(
 typedef void (* rmw_uros_continous_serialization)(
   ucdrBuffer * ucdr);
 
+/// Contiguous chunk of user memory appended to a serialized message.
+typedef struct rmw_uros_segment_t
+{
+  /// Start of the chunk.
+  const uint8_t * data;
+  /// Length of the chunk in bytes.
+  size_t length;
+} rmw_uros_segment_t;
+
 /** \addtogroup rmw micro-ROS RMW API
  *  @{
  */
@@ -51,6 +60,29 @@ void rmw_uros_set_continous_serialization_callbacks(
   rmw_uros_continous_serialization_size size_cb,
   rmw_uros_continous_serialization serialization_cb);
 
+/**
+ * \brief Publishes a message followed by a list of user memory segments
+ *
+ * The message is serialized as in `rmw_publish` and the segments are then copied one after
+ * another directly into the output stream, fragmenting the sample if needed. No intermediate
+ * copy of the segments is made.
+ * The segments are appended verbatim, so they must hold the CDR representation of the fields
+ * not included in the message (e.g. the length of a sequence followed by its elements).
+ *
+ * \param[in] publisher publisher used to send the sample
+ * \param[in] ros_message message serialized before the segments
+ * \param[in] segments array of segments to append
+ * \param[in] segment_count number of segments
+ * \return RMW_RET_OK when success.
+ * \return RMW_RET_INVALID_ARGUMENT If any argument is not valid.
+ * \return RMW_RET_ERROR If the sample cannot be published.
+ */
+rmw_ret_t rmw_uros_publish_segments(
+  const rmw_publisher_t * publisher,
+  const void * ros_message,
+  const rmw_uros_segment_t * segments,
+  size_t segment_count);
+
 /** @}*/
 
 #if defined(__cplusplus)
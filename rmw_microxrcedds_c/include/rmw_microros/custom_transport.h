@@ -81,6 +81,30 @@ rmw_ret_t rmw_uros_options_set_custom_transport(
   read_custom_func read_cb,
   rmw_init_options_t * rmw_options);
 
+/**
+ * \brief Callback used to interrupt a blocking read of a custom transport.
+ *
+ * \param[in] args Arguments given when the callback was set.
+ */
+typedef void (* rmw_uros_custom_transport_wakeup_func)(void * args);
+
+/**
+ * \brief Sets a callback that is called when a guard condition is triggered.
+ *
+ * While `rmw_wait` is blocked in the custom transport read callback, triggering a guard condition
+ * calls `wakeup_cb` from the triggering thread. The callback should make the pending read return
+ * early (e.g. by giving a semaphore or sending an event), so the wait is interrupted immediately.
+ * Without it, the trigger is noticed once the pending read times out, which takes at most 100 ms.
+ * The callback can be set or changed from any thread.
+ *
+ * \param[in] wakeup_cb Wakeup callback, NULL disables it.
+ * \param[in] args Arguments for the wakeup callback.
+ * \return RMW_RET_OK If correct.
+ */
+rmw_ret_t rmw_uros_set_custom_transport_wakeup(
+  rmw_uros_custom_transport_wakeup_func wakeup_cb,
+  void * args);
+
 /** @}*/
 
 #if defined(__cplusplus)
@@ -0,0 +1,78 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ */
+
+#ifndef RMW_MICROROS__EVENT_LOOP_H_
+#define RMW_MICROROS__EVENT_LOOP_H_
+
+#include <rmw/rmw.h>
+#include <rmw/ret_types.h>
+#include <rmw/init.h>
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif  // if defined(__cplusplus)
+
+/** \addtogroup rmw micro-ROS RMW API
+ *  @{
+ */
+
+/**
+ * \brief Returns the file descriptor of the transport used by a micro-ROS context.
+ *
+ * The descriptor becomes readable when the Agent has sent data to the session, so it can be
+ * registered in an external event loop (e.g. epoll, libuv) as level-triggered input.
+ * When it is readable `rmw_uros_process_ready_io` must be called.
+ * The descriptor is owned by the context and must not be read, written or closed by the user.
+ *
+ * \param[in] context micro-ROS context.
+ * \param[out] fd transport file descriptor.
+ * \return RMW_RET_OK when success.
+ * \return RMW_RET_INVALID_ARGUMENT If context or fd are not valid.
+ * \return RMW_RET_UNSUPPORTED If the session is spun by an I/O thread (RMW_UXRCE_IO_THREAD).
+ */
+rmw_ret_t rmw_uros_get_context_fd(
+  const rmw_context_t * context,
+  int * fd);
+
+/**
+ * \brief Processes the incoming data already available in the transport of a micro-ROS context
+ *        without blocking.
+ *
+ * Received samples, requests and replies are buffered in their entities, which can then be
+ * handled with a zero timeout `rmw_wait` (e.g. an executor `spin_some`).
+ * Each call serves the session until nothing is left in the transport, including complete
+ * frames already buffered by the transport framing, which do not make the descriptor readable.
+ * This function cannot be called concurrently with `rmw_init()` or `rmw_shutdown()`.
+ *
+ * \param[in] context micro-ROS context.
+ * \return RMW_RET_OK when success.
+ * \return RMW_RET_INVALID_ARGUMENT If context is not valid.
+ * \return RMW_RET_ERROR If the transport has been closed or has failed.
+ * \return RMW_RET_UNSUPPORTED If the session is spun by an I/O thread (RMW_UXRCE_IO_THREAD).
+ */
+rmw_ret_t rmw_uros_process_ready_io(
+  const rmw_context_t * context);
+
+/** @}*/
+
+#if defined(__cplusplus)
+}
+#endif  // if defined(__cplusplus)
+
+#endif  // RMW_MICROROS__EVENT_LOOP_H_
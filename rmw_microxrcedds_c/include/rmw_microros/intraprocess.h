@@ -0,0 +1,66 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ */
+
+#ifndef RMW_MICROROS__INTRAPROCESS_H_
+#define RMW_MICROROS__INTRAPROCESS_H_
+
+#include <stdbool.h>
+
+#include <rmw/rmw.h>
+#include <rmw/ret_types.h>
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif  // if defined(__cplusplus)
+
+/** \addtogroup rmw micro-ROS RMW API
+ *  @{
+ */
+
+/**
+ * \brief Restricts the delivery of a publisher to the subscriptions of its own context.
+ *
+ * Samples published by a local only publisher are handed directly to the matching
+ * subscriptions of the same context and never sent to the Agent, so remote subscribers
+ * will not receive them. Samples of other publishers reach local subscriptions through
+ * the Agent.
+ *
+ * Publishing to both paths at once is not supported: samples coming back from the Agent
+ * cannot be told apart from remote ones, so local subscriptions would receive them twice.
+ * Local only publishers are not detected either, the application selects them explicitly.
+ *
+ * Publishing fails if the sample does not fit in an input buffer, cannot be serialized
+ * or some matching subscription has no input buffer available for it.
+ *
+ * \param[in] publisher publisher to configure.
+ * \param[in] local_only true to stop forwarding samples to the Agent.
+ * \return RMW_RET_OK when success.
+ * \return RMW_RET_INVALID_ARGUMENT If publisher is not valid.
+ */
+rmw_ret_t rmw_uros_set_publisher_local_only(
+  rmw_publisher_t * publisher,
+  bool local_only);
+
+/** @}*/
+
+#if defined(__cplusplus)
+}
+#endif  // if defined(__cplusplus)
+
+#endif  // RMW_MICROROS__INTRAPROCESS_H_
@@ -0,0 +1,63 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ */
+
+#ifndef RMW_MICROROS__LARGE_SAMPLES_H_
+#define RMW_MICROROS__LARGE_SAMPLES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <rmw/rmw.h>
+#include <rmw/ret_types.h>
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif  // if defined(__cplusplus)
+
+/** \addtogroup rmw micro-ROS RMW API
+ *  @{
+ */
+
+/**
+ * \brief Sets a user-provided buffer to store the large samples of a subscription.
+ *
+ * Samples bigger than RMW_UXRCE_STATIC_INPUT_BUFFER_SIZE are stored in this buffer instead of
+ * a history slot. It holds a single sample at a time, when it is busy the large input buffers
+ * pool is used.
+ * The buffer must remain valid until the subscription is destroyed or the buffer is replaced.
+ *
+ * \param[in] subscription subscription to configure.
+ * \param[in] buffer user-provided buffer, NULL disables it.
+ * \param[in] size size of the buffer in bytes.
+ * \return RMW_RET_OK when success.
+ * \return RMW_RET_INVALID_ARGUMENT If subscription is not valid.
+ * \return RMW_RET_ERROR If the current buffer holds a sample not taken yet.
+ */
+rmw_ret_t rmw_uros_set_subscription_large_buffer(
+  rmw_subscription_t * subscription,
+  uint8_t * buffer,
+  size_t size);
+
+/** @}*/
+
+#if defined(__cplusplus)
+}
+#endif  // if defined(__cplusplus)
+
+#endif  // RMW_MICROROS__LARGE_SAMPLES_H_
@@ -0,0 +1,135 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ */
+
+#ifndef RMW_MICROROS__MESSAGE_TEMPLATE_H_
+#define RMW_MICROROS__MESSAGE_TEMPLATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <rmw/rmw.h>
+#include <rmw/ret_types.h>
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif  // if defined(__cplusplus)
+
+/** \addtogroup rmw micro-ROS RMW API
+ *  @{
+ */
+
+#define RMW_UROS_MESSAGE_TEMPLATE_MAX_FIELDS 8
+
+/// Field of a message template patched on each publication.
+typedef struct rmw_uros_message_template_field_t
+{
+  /// Offset of the field in the ROS message structure.
+  size_t member_offset;
+  /// Offset of the field in the serialized message.
+  size_t cdr_offset;
+  /// Size of the field in bytes.
+  size_t size;
+} rmw_uros_message_template_field_t;
+
+/**
+ * \brief Pre-serialized message of a publisher.
+ *
+ * The template must be initialized with `rmw_uros_init_message_template`.
+ */
+typedef struct rmw_uros_message_template_t
+{
+  const rmw_publisher_t * publisher;
+  /// User-provided buffer, its first half holds the serialized message.
+  uint8_t * buffer;
+  size_t buffer_size;
+  /// Length of the serialized message.
+  size_t length;
+  rmw_uros_message_template_field_t fields[RMW_UROS_MESSAGE_TEMPLATE_MAX_FIELDS];
+  size_t field_count;
+} rmw_uros_message_template_t;
+
+/**
+ * \brief Serializes a message used as template for the publications of a publisher.
+ *
+ * The first half of the buffer stores the serialized message and the second half is used
+ * to locate the fields added with `rmw_uros_message_template_add_field`, so the buffer must
+ * hold twice the serialized size of the message.
+ * Continous serialization callbacks of the publisher are not used by templates.
+ *
+ * \param[out] message_template template to initialize.
+ * \param[in] publisher publisher that will send the template.
+ * \param[in] ros_message message to serialize.
+ * \param[in] buffer user-provided buffer, must remain valid while the template is used.
+ * \param[in] buffer_size size of the buffer in bytes.
+ * \return RMW_RET_OK when success.
+ * \return RMW_RET_INVALID_ARGUMENT If any argument is not valid.
+ * \return RMW_RET_ERROR If the message does not fit in the buffer.
+ */
+rmw_ret_t rmw_uros_init_message_template(
+  rmw_uros_message_template_t * message_template,
+  const rmw_publisher_t * publisher,
+  const void * ros_message,
+  uint8_t * buffer,
+  size_t buffer_size);
+
+/**
+ * \brief Adds a field to be patched in a template on each publication.
+ *
+ * Only numeric primitive fields, not included in a sequence, are supported.
+ * The location of the field in the serialized message is found by serializing the message
+ * with the field temporarily modified, so `ros_message` must be the message used to
+ * initialize the template or one with the same contents.
+ *
+ * \param[in,out] message_template template to update.
+ * \param[in] ros_message message containing the field, restored before returning.
+ * \param[in] field pointer to the field inside `ros_message`.
+ * \param[in] field_size size of the field in bytes (1, 2, 4 or 8).
+ * \return RMW_RET_OK when success.
+ * \return RMW_RET_INVALID_ARGUMENT If any argument is not valid.
+ * \return RMW_RET_ERROR If the field cannot be located or there is no room for more fields.
+ */
+rmw_ret_t rmw_uros_message_template_add_field(
+  rmw_uros_message_template_t * message_template,
+  void * ros_message,
+  void * field,
+  size_t field_size);
+
+/**
+ * \brief Publishes a template, copying the added fields from a message.
+ *
+ * The template is copied into the output stream without serializing the message again.
+ *
+ * \param[in,out] message_template template to publish.
+ * \param[in] ros_message message holding the new value of the fields, NULL to publish
+ *            the template as it is.
+ * \return RMW_RET_OK when success.
+ * \return RMW_RET_INVALID_ARGUMENT If the template is not initialized.
+ * \return RMW_RET_ERROR If the sample cannot be published.
+ */
+rmw_ret_t rmw_uros_publish_message_template(
+  rmw_uros_message_template_t * message_template,
+  const void * ros_message);
+
+/** @}*/
+
+#if defined(__cplusplus)
+}
+#endif  // if defined(__cplusplus)
+
+#endif  // RMW_MICROROS__MESSAGE_TEMPLATE_H_
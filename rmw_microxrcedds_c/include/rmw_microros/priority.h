@@ -0,0 +1,62 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ */
+
+#ifndef RMW_MICROROS__PRIORITY_H_
+#define RMW_MICROROS__PRIORITY_H_
+
+#include <stdint.h>
+
+#include <rmw/rmw.h>
+#include <rmw/ret_types.h>
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif  // if defined(__cplusplus)
+
+/** \addtogroup rmw micro-ROS RMW API
+ *  @{
+ */
+
+/**
+ * \brief Maps a publisher to a priority class.
+ *
+ * Each priority class has its own reliable output stream, so a large transfer in a lower
+ * priority class does not hold the history slots needed by a higher priority one, and
+ * reliable publications only wait for the acknowledgements of their own stream.
+ * Streams of higher priority classes are served first when the session is flushed.
+ * Best effort publishers share a single output stream, the class only selects the reliable
+ * stream used to fragment their samples.
+ * The number of classes is set by `RMW_UXRCE_PRIORITY_CLASSES`, all publishers start in class 0.
+ *
+ * \param[in] publisher publisher to configure.
+ * \param[in] priority_class priority class, 0 is the highest priority.
+ * \return RMW_RET_OK when success.
+ * \return RMW_RET_INVALID_ARGUMENT If publisher or priority_class are not valid.
+ */
+rmw_ret_t rmw_uros_set_publisher_priority_class(
+  rmw_publisher_t * publisher,
+  uint8_t priority_class);
+
+/** @}*/
+
+#if defined(__cplusplus)
+}
+#endif  // if defined(__cplusplus)
+
+#endif  // RMW_MICROROS__PRIORITY_H_
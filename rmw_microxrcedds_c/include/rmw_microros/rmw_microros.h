@@ -26,6 +26,10 @@
 #include <rmw_microros/time_sync.h>
 #include <rmw_microros/ping.h>
 #include <rmw_microros/timing.h>
+#include <rmw_microros/warm_restart.h>
+#include <rmw_microros/large_samples.h>
+#include <rmw_microros/message_template.h>
+#include <rmw_microros/priority.h>
 
 #if defined(RMW_UXRCE_TRANSPORT_UDP) || defined(RMW_UXRCE_TRANSPORT_TCP)
 #include <rmw_microros/discovery.h>
@@ -35,6 +39,14 @@
 #include <rmw_microros/custom_transport.h>
 #endif  // RMW_UXRCE_TRANSPORT_CUSTOM
 
+#if defined(UCLIENT_PLATFORM_POSIX) && !defined(RMW_UXRCE_TRANSPORT_CUSTOM)
+#include <rmw_microros/event_loop.h>
+#endif  // if defined(UCLIENT_PLATFORM_POSIX) && !defined(RMW_UXRCE_TRANSPORT_CUSTOM)
+
+#ifdef RMW_UXRCE_INTRAPROCESS
+#include <rmw_microros/intraprocess.h>
+#endif  // RMW_UXRCE_INTRAPROCESS
+
 #ifdef RMW_UROS_ERROR_HANDLING
 #include <rmw_microros/error_handling.h>
 #endif  // RMW_UROS_ERROR_HANDLING
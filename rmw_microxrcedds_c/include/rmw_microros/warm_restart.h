@@ -0,0 +1,104 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ */
+
+#ifndef RMW_MICROROS__WARM_RESTART_H_
+#define RMW_MICROROS__WARM_RESTART_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <rmw/rmw.h>
+#include <rmw/ret_types.h>
+#include <rmw/init_options.h>
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif  // if defined(__cplusplus)
+
+/** \addtogroup rmw micro-ROS RMW API
+ *  @{
+ */
+
+#define RMW_UROS_SESSION_STORE_MAGIC 0x58524345
+
+/**
+ * \brief Session state kept across client reboots.
+ *
+ * The user owns this structure and is responsible for placing it in a memory that survives
+ * a reboot (e.g. a no-init RAM section or a flash page).
+ * It must be zero initialized before its first use.
+ */
+typedef struct rmw_uros_session_store_t
+{
+  /// Set to RMW_UROS_SESSION_STORE_MAGIC when the stored state is valid.
+  uint32_t magic;
+  /// Client key of the session owning the Agent side entities.
+  uint32_t client_key;
+  /// Hash of the object ids and names of the entities created in the stored session.
+  uint32_t topology_hash;
+  /// Number of entities created in the stored session.
+  uint16_t entity_count;
+} rmw_uros_session_store_t;
+
+/**
+ * \brief Sets a user-provided store used to warm restart the XRCE session.
+ *
+ * If the store contains a valid state when `rmw_init` is called, the stored client key is used
+ * so the Agent keeps the entities of the previous session. Until the stored topology is
+ * recreated, entity creation requests are pipelined and their status is verified in batches
+ * instead of waiting for each of them.
+ * If a batch fails or the recreated topology does not match the stored one, every entity of
+ * the session is created again waiting for its status.
+ * The store is updated while entities are created and invalidated in `rmw_context_fini`.
+ *
+ * \param[in] store user-provided session store, NULL disables the warm restart.
+ * \param[in,out] rmw_options Updated options with rmw specifics.
+ * \return RMW_RET_OK If arguments were valid and set in rmw_init_options.
+ * \return RMW_RET_INVALID_ARGUMENT If rmw_init_options is not valid or unexpected arguments.
+ */
+rmw_ret_t rmw_uros_options_set_session_store(
+  rmw_uros_session_store_t * store,
+  rmw_init_options_t * rmw_options);
+
+/**
+ * \brief Checks if a session store contains a state that can be used for a warm restart.
+ *
+ * \param[in] store session store to check.
+ * \return true if the store holds a valid session state.
+ */
+bool rmw_uros_session_store_is_valid(
+  const rmw_uros_session_store_t * store);
+
+/**
+ * \brief Invalidates a session store, forcing a cold start in the next `rmw_init`.
+ *
+ * \param[in,out] store session store to invalidate.
+ * \return RMW_RET_OK when success.
+ * \return RMW_RET_INVALID_ARGUMENT If store is not valid.
+ */
+rmw_ret_t rmw_uros_session_store_invalidate(
+  rmw_uros_session_store_t * store);
+
+/** @}*/
+
+#if defined(__cplusplus)
+}
+#endif  // if defined(__cplusplus)
+
+#endif  // RMW_MICROROS__WARM_RESTART_H_
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <rmw_microros_internal/callbacks.h>
+#include "./rmw_microros_internal/rmw_event.h"
+#include "./rmw_microros_internal/io_thread.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
 void on_status(
@@ -24,9 +26,26 @@ void on_status(
 {
   (void)session;
   (void)object_id;
-  (void)request_id;
-  (void)status;
-  (void)args;
+
+  rmw_context_impl_t * context_impl = (rmw_context_impl_t *)(args);
+
+#ifdef RMW_UXRCE_IO_THREAD
+  // The I/O thread may receive a reply before its caller starts waiting for it
+  rmw_uxrce_io_thread_push_status(context_impl, request_id, status);
+#endif  // RMW_UXRCE_IO_THREAD
+
+  // Track pipelined creation requests of a warm restart
+  for (size_t i = 0; i < context_impl->resume_requests_count; i++) {
+    if (context_impl->resume_requests[i] == request_id) {
+      if (UXR_STATUS_OK != status && UXR_STATUS_OK_MATCHED != status) {
+        context_impl->resume_failed = true;
+      }
+      context_impl->resume_requests_count--;
+      context_impl->resume_requests[i] =
+        context_impl->resume_requests[context_impl->resume_requests_count];
+      break;
+    }
+  }
 }
 
 void on_topic(
@@ -69,12 +88,15 @@ void on_topic(
     if ((custom_subscription->datareader_id.id == object_id.id) &&
       (custom_subscription->datareader_id.type == object_id.type))
     {
-      UXR_LOCK(&static_buffer_memory.mutex);
+      bool sample_lost = false;
+      rmw_uxrce_static_input_buffer_t * static_buffer = rmw_uxrce_input_queue_reserve(
+        &custom_subscription->input_queue, &custom_subscription->qos, &sample_lost);
+
+      if (sample_lost) {
+        rmw_uxrce_subscription_message_lost(custom_subscription);
+      }
 
-      rmw_uxrce_mempool_item_t * memory_node = rmw_uxrce_get_static_input_buffer_for_entity(
-        custom_subscription, custom_subscription->qos);
-      if (!memory_node) {
-        UXR_UNLOCK(&static_buffer_memory.mutex);
+      if (!static_buffer) {
         RMW_UROS_TRACE_ERROR(
           RMW_UROS_ERROR_ON_SUBSCRIPTION, RMW_UROS_ERROR_MIDDLEWARE_ALLOCATION,
           "Not available static buffer memory node in on_topic callback",
@@ -86,23 +108,35 @@ void on_topic(
         return;
       }
 
-      rmw_uxrce_static_input_buffer_t * static_buffer =
-        (rmw_uxrce_static_input_buffer_t *)memory_node->data;
+      if (!rmw_uxrce_static_input_buffer_fit(
+          static_buffer, &custom_subscription->user_buffer, length))
+      {
+        rmw_uxrce_input_queue_cancel(&custom_subscription->input_queue, static_buffer);
+        rmw_uxrce_subscription_message_lost(custom_subscription);
+        RMW_UROS_TRACE_ERROR(
+          RMW_UROS_ERROR_ON_SUBSCRIPTION, RMW_UROS_ERROR_MIDDLEWARE_ALLOCATION,
+          "Not available large input buffer in on_topic callback",
+          .node = custom_subscription->owner_node->node_name,
+          .node_namespace = custom_subscription->owner_node->node_namespace,
+          .topic_name = custom_subscription->topic_name, .ucdr = ub,
+          .size = length,
+          .type_support.message_callbacks = custom_subscription->type_support_callbacks);
+        return;
+      }
 
       if (!ucdr_deserialize_array_uint8_t(
           ub,
           static_buffer->buffer,
           length))
       {
-        put_memory(&static_buffer_memory, memory_node);
+        rmw_uxrce_input_queue_cancel(&custom_subscription->input_queue, static_buffer);
       } else {
-        static_buffer->owner = (void *) custom_subscription;
         static_buffer->length = length;
         static_buffer->timestamp = rmw_uros_epoch_nanos();
-        static_buffer->entity_type = RMW_UXRCE_ENTITY_TYPE_SUBSCRIPTION;
+        rmw_uxrce_input_queue_push(&custom_subscription->input_queue, static_buffer);
+        rmw_uxrce_subscription_sample_received(custom_subscription);
       }
 
-      UXR_UNLOCK(&static_buffer_memory.mutex);
       return;
     }
     subscription_item = subscription_item->next;
@@ -128,12 +162,9 @@ void on_request(
     // Check if request is related to the service
     rmw_uxrce_service_t * custom_service = (rmw_uxrce_service_t *)service_item->data;
     if (custom_service->service_data_resquest == request_id) {
-      UXR_LOCK(&static_buffer_memory.mutex);
-
-      rmw_uxrce_mempool_item_t * memory_node = rmw_uxrce_get_static_input_buffer_for_entity(
-        custom_service, custom_service->qos);
-      if (!memory_node) {
-        UXR_UNLOCK(&static_buffer_memory.mutex);
+      rmw_uxrce_static_input_buffer_t * static_buffer = rmw_uxrce_input_queue_reserve(
+        &custom_service->input_queue, &custom_service->qos, NULL);
+      if (!static_buffer) {
         RMW_UROS_TRACE_ERROR(
           RMW_UROS_ERROR_ON_SERVICE, RMW_UROS_ERROR_MIDDLEWARE_ALLOCATION,
           "Not available static buffer memory node in on_request callback",
@@ -145,25 +176,32 @@ void on_request(
         return;
       }
 
-      rmw_uxrce_static_input_buffer_t * static_buffer =
-        (rmw_uxrce_static_input_buffer_t *)memory_node->data;
+      if (!rmw_uxrce_static_input_buffer_fit(static_buffer, NULL, length)) {
+        rmw_uxrce_input_queue_cancel(&custom_service->input_queue, static_buffer);
+        RMW_UROS_TRACE_ERROR(
+          RMW_UROS_ERROR_ON_SERVICE, RMW_UROS_ERROR_MIDDLEWARE_ALLOCATION,
+          "Not available large input buffer in on_request callback",
+          .node = custom_service->owner_node->node_name,
+          .node_namespace = custom_service->owner_node->node_namespace,
+          .topic_name = custom_service->service_name, .ucdr = ub,
+          .size = length,
+          .type_support.service_callbacks = custom_service->type_support_callbacks);
+        return;
+      }
 
       if (!ucdr_deserialize_array_uint8_t(
           ub,
           static_buffer->buffer,
           length))
       {
-        put_memory(&static_buffer_memory, memory_node);
+        rmw_uxrce_input_queue_cancel(&custom_service->input_queue, static_buffer);
       } else {
-        static_buffer->owner = (void *) custom_service;
         static_buffer->length = length;
         static_buffer->related.sample_id = *sample_id;
         static_buffer->timestamp = rmw_uros_epoch_nanos();
-        static_buffer->entity_type = RMW_UXRCE_ENTITY_TYPE_SERVICE;
+        rmw_uxrce_input_queue_push(&custom_service->input_queue, static_buffer);
       }
 
-      UXR_UNLOCK(&static_buffer_memory.mutex);
-
       return;
     }
     service_item = service_item->next;
@@ -189,12 +227,9 @@ void on_reply(
     // Check if reply is related to the client
     rmw_uxrce_client_t * custom_client = (rmw_uxrce_client_t *)client_item->data;
     if (custom_client->client_data_request == request_id) {
-      UXR_LOCK(&static_buffer_memory.mutex);
-
-      rmw_uxrce_mempool_item_t * memory_node = rmw_uxrce_get_static_input_buffer_for_entity(
-        custom_client, custom_client->qos);
-      if (!memory_node) {
-        UXR_UNLOCK(&static_buffer_memory.mutex);
+      rmw_uxrce_static_input_buffer_t * static_buffer = rmw_uxrce_input_queue_reserve(
+        &custom_client->input_queue, &custom_client->qos, NULL);
+      if (!static_buffer) {
         RMW_UROS_TRACE_ERROR(
           RMW_UROS_ERROR_ON_CLIENT, RMW_UROS_ERROR_MIDDLEWARE_ALLOCATION,
           "Not available static buffer memory node in on_reply callback",
@@ -206,23 +241,31 @@ void on_reply(
         return;
       }
 
-      rmw_uxrce_static_input_buffer_t * static_buffer =
-        (rmw_uxrce_static_input_buffer_t *)memory_node->data;
+      if (!rmw_uxrce_static_input_buffer_fit(static_buffer, NULL, length)) {
+        rmw_uxrce_input_queue_cancel(&custom_client->input_queue, static_buffer);
+        RMW_UROS_TRACE_ERROR(
+          RMW_UROS_ERROR_ON_CLIENT, RMW_UROS_ERROR_MIDDLEWARE_ALLOCATION,
+          "Not available large input buffer in on_reply callback",
+          .node = custom_client->owner_node->node_name,
+          .node_namespace = custom_client->owner_node->node_namespace,
+          .topic_name = custom_client->service_name, .ucdr = ub,
+          .size = length,
+          .type_support.service_callbacks = custom_client->type_support_callbacks);
+        return;
+      }
 
       if (!ucdr_deserialize_array_uint8_t(
           ub,
           static_buffer->buffer,
           length))
       {
-        put_memory(&static_buffer_memory, memory_node);
+        rmw_uxrce_input_queue_cancel(&custom_client->input_queue, static_buffer);
       } else {
-        static_buffer->owner = (void *) custom_client;
         static_buffer->length = length;
         static_buffer->related.reply_id = reply_id;
         static_buffer->timestamp = rmw_uros_epoch_nanos();
-        static_buffer->entity_type = RMW_UXRCE_ENTITY_TYPE_CLIENT;
+        rmw_uxrce_input_queue_push(&custom_client->input_queue, static_buffer);
       }
-      UXR_UNLOCK(&static_buffer_memory.mutex);
 
       return;
     }
@@ -0,0 +1,146 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rmw_microros_internal/intraprocess.h>
+
+#ifdef RMW_UXRCE_INTRAPROCESS
+
+#include <string.h>
+
+#include <rmw_microros/time_sync.h>
+
+#include "./rmw_microros_internal/rmw_event.h"
+#include "./rmw_microros_internal/wakeup.h"
+#include "./rmw_microros_internal/error_handling_internal.h"
+
+static bool rmw_uxrce_intraprocess_matches(
+  const rmw_uxrce_publisher_t * publisher,
+  const rmw_uxrce_subscription_t * subscription)
+{
+  return subscription->owner_node->context == publisher->owner_node->context &&
+         subscription->type_support_callbacks == publisher->type_support_callbacks &&
+         0 == strcmp(subscription->topic_name, publisher->topic_name);
+}
+
+// Returns the reserved buffers to the pool without delivering them
+static void rmw_uxrce_intraprocess_cancel(
+  rmw_uxrce_subscription_t ** subscriptions,
+  rmw_uxrce_static_input_buffer_t ** buffers,
+  size_t count)
+{
+  for (size_t i = 0; i < count; i++) {
+    rmw_uxrce_input_queue_cancel(&subscriptions[i]->input_queue, buffers[i]);
+  }
+}
+
+bool rmw_uxrce_intraprocess_publish(
+  rmw_uxrce_publisher_t * publisher,
+  const void * ros_message,
+  const rmw_uros_segment_t * segments,
+  size_t segment_count,
+  size_t topic_length)
+{
+  if (topic_length > RMW_UXRCE_STATIC_INPUT_BUFFER_SIZE) {
+    RMW_UROS_TRACE_MESSAGE("sample too large for intra-process delivery")
+    return false;
+  }
+
+  rmw_uxrce_subscription_t * subscriptions[RMW_UXRCE_MAX_SUBSCRIPTIONS];
+  rmw_uxrce_static_input_buffer_t * buffers[RMW_UXRCE_MAX_SUBSCRIPTIONS];
+  size_t count = 0;
+  bool delivered = true;
+
+  // The pool is held until the samples are pushed, so no subscription is destroyed meanwhile
+  UXR_LOCK(&subscription_memory.mutex);
+
+  rmw_uxrce_mempool_item_t * item = subscription_memory.allocateditems;
+  while (item != NULL && count < RMW_UXRCE_MAX_SUBSCRIPTIONS) {
+    rmw_uxrce_subscription_t * custom_subscription = (rmw_uxrce_subscription_t *)item->data;
+    item = item->next;
+
+    if (!rmw_uxrce_intraprocess_matches(publisher, custom_subscription)) {
+      continue;
+    }
+
+    bool sample_lost = false;
+    rmw_uxrce_static_input_buffer_t * static_buffer = rmw_uxrce_input_queue_reserve(
+      &custom_subscription->input_queue, &custom_subscription->qos, &sample_lost);
+
+    if (sample_lost) {
+      rmw_uxrce_subscription_message_lost(custom_subscription);
+    }
+
+    if (NULL == static_buffer) {
+      RMW_UROS_TRACE_MESSAGE("no input buffer available for intra-process delivery")
+      delivered = false;
+      continue;
+    }
+
+    subscriptions[count] = custom_subscription;
+    buffers[count] = static_buffer;
+    count++;
+  }
+
+  if (0 == count) {
+    UXR_UNLOCK(&subscription_memory.mutex);
+    return delivered;
+  }
+
+  // Serialize once and copy the result to the rest of subscriptions
+  ucdrBuffer mb;
+  ucdr_init_buffer(&mb, buffers[0]->buffer, RMW_UXRCE_STATIC_INPUT_BUFFER_SIZE);
+
+  bool serialized = true;
+  if (NULL != ros_message) {
+    serialized = publisher->type_support_callbacks->cdr_serialize(ros_message, &mb);
+    if (publisher->cs_cb_serialization) {
+      publisher->cs_cb_serialization(&mb);
+    }
+  }
+
+  for (size_t i = 0; i < segment_count && serialized; i++) {
+    serialized = ucdr_serialize_array_uint8_t(&mb, segments[i].data, segments[i].length);
+  }
+
+  if (!serialized || mb.error) {
+    rmw_uxrce_intraprocess_cancel(subscriptions, buffers, count);
+    UXR_UNLOCK(&subscription_memory.mutex);
+    RMW_UROS_TRACE_MESSAGE("intra-process serialization error")
+    return false;
+  }
+
+  size_t length = ucdr_buffer_length(&mb);
+  int64_t now = rmw_uros_epoch_nanos();
+
+  for (size_t i = 0; i < count; i++) {
+    if (0 < i) {
+      memcpy(buffers[i]->buffer, buffers[0]->buffer, length);
+    }
+
+    buffers[i]->length = length;
+    buffers[i]->timestamp = now;
+
+    rmw_uxrce_input_queue_push(&subscriptions[i]->input_queue, buffers[i]);
+    rmw_uxrce_subscription_sample_received(subscriptions[i]);
+  }
+
+  UXR_UNLOCK(&subscription_memory.mutex);
+
+  // Unlike samples from the Agent, nothing arrives on the transports a wait is blocked on
+  rmw_uxrce_wakeup_signal();
+
+  return delivered;
+}
+
+#endif  // RMW_UXRCE_INTRAPROCESS
@@ -0,0 +1,276 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rmw_microros_internal/io_thread.h>
+
+#ifdef RMW_UXRCE_IO_THREAD
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "./rmw_microros_internal/rmw_uxrce_transports.h"
+#include "./rmw_microros_internal/error_handling_internal.h"
+
+static void * io_thread_main(
+  void * args)
+{
+  rmw_context_impl_t * context = (rmw_context_impl_t *)args;
+
+  struct pollfd fds[2];
+  fds[0].fd = rmw_uxrce_transport_fd(context);
+  fds[0].events = POLLIN;
+  fds[1].fd = context->io_thread_stop_pipe[0];
+  fds[1].events = POLLIN;
+  bool transport_failed = false;
+
+  for (;;) {
+    // The session is only held while it is served, never while blocked on the transport.
+    // Frames already buffered by the transport framing do not make it readable, so the
+    // session is served for as long as it receives data. Callbacks fill the static input
+    // buffers while the session is ran.
+    bool data_received = false;
+    while (uxr_run_session_until_data(&context->session, 0)) {
+      data_received = true;
+    }
+
+    if (data_received) {
+      rmw_uxrce_io_thread_notify(context);
+    }
+
+    // A closed or failed transport stays readable, so it is no longer polled and the
+    // session is only served each period until the thread is stopped
+    fds[0].revents = 0;
+    fds[1].revents = 0;
+    if (transport_failed) {
+      if (0 > poll(&fds[1], 1, RMW_UXRCE_IO_THREAD_PERIOD) && EINTR != errno) {
+        RMW_UROS_TRACE_MESSAGE("Session I/O thread cannot poll its stop pipe")
+        break;
+      }
+    } else if (0 > poll(fds, 2, RMW_UXRCE_IO_THREAD_PERIOD) && EINTR != errno) {
+      RMW_UROS_TRACE_MESSAGE("Session I/O thread cannot poll its transport")
+      break;
+    }
+
+    if (fds[1].revents & POLLIN) {
+      break;
+    }
+
+    if (fds[0].revents & RMW_UXRCE_TRANSPORT_POLL_ERROR) {
+      RMW_UROS_TRACE_MESSAGE("Session transport closed or failed")
+      transport_failed = true;
+    }
+  }
+
+  return NULL;
+}
+
+bool rmw_uxrce_io_thread_start(
+  rmw_context_impl_t * context)
+{
+  context->io_thread_running = false;
+
+  if (0 != pipe(context->io_thread_stop_pipe)) {
+    RMW_UROS_TRACE_MESSAGE("Cannot create session I/O thread stop pipe")
+    return false;
+  }
+
+  fcntl(context->io_thread_stop_pipe[0], F_SETFD, FD_CLOEXEC);
+  fcntl(context->io_thread_stop_pipe[1], F_SETFD, FD_CLOEXEC);
+
+  context->io_thread_running =
+    0 == pthread_create(&context->io_thread, NULL, io_thread_main, (void *)context);
+
+  if (!context->io_thread_running) {
+    RMW_UROS_TRACE_MESSAGE("Cannot create session I/O thread")
+    close(context->io_thread_stop_pipe[0]);
+    close(context->io_thread_stop_pipe[1]);
+  }
+
+  return context->io_thread_running;
+}
+
+void rmw_uxrce_io_thread_stop(
+  rmw_context_impl_t * context)
+{
+  if (!context->io_thread_running) {
+    return;
+  }
+
+  const uint8_t token = 0;
+  ssize_t ret = write(context->io_thread_stop_pipe[1], &token, sizeof(token));
+  (void)ret;
+
+  pthread_join(context->io_thread, NULL);
+  context->io_thread_running = false;
+
+  close(context->io_thread_stop_pipe[0]);
+  close(context->io_thread_stop_pipe[1]);
+}
+
+void rmw_uxrce_io_thread_init_wait_set(
+  rmw_uxrce_wait_set_t * wait_set)
+{
+  pthread_condattr_t attr;
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init(&wait_set->io_cond, &attr);
+  pthread_condattr_destroy(&attr);
+
+  pthread_mutex_init(&wait_set->io_mutex, NULL);
+  wait_set->io_sequence = 0;
+}
+
+void rmw_uxrce_io_thread_fini_wait_set(
+  rmw_uxrce_wait_set_t * wait_set)
+{
+  pthread_cond_destroy(&wait_set->io_cond);
+  pthread_mutex_destroy(&wait_set->io_mutex);
+}
+
+static void notify_wait_set(
+  rmw_uxrce_wait_set_t * wait_set)
+{
+  pthread_mutex_lock(&wait_set->io_mutex);
+  wait_set->io_sequence++;
+  pthread_cond_broadcast(&wait_set->io_cond);
+  pthread_mutex_unlock(&wait_set->io_mutex);
+}
+
+void rmw_uxrce_io_thread_notify(
+  rmw_context_impl_t * context)
+{
+  size_t index = (size_t)(context - custom_sessions);
+
+  // Only the wait sets whose entities belong to this session are woken up
+  UXR_LOCK(&wait_set_memory.mutex);
+
+  rmw_uxrce_mempool_item_t * item = wait_set_memory.allocateditems;
+  while (NULL != item) {
+    rmw_uxrce_wait_set_t * wait_set = (rmw_uxrce_wait_set_t *)item->data;
+    if (wait_set->session_cached[index]) {
+      notify_wait_set(wait_set);
+    }
+    item = item->next;
+  }
+
+  UXR_UNLOCK(&wait_set_memory.mutex);
+}
+
+void rmw_uxrce_io_thread_notify_all(void)
+{
+  UXR_LOCK(&wait_set_memory.mutex);
+
+  rmw_uxrce_mempool_item_t * item = wait_set_memory.allocateditems;
+  while (NULL != item) {
+    notify_wait_set((rmw_uxrce_wait_set_t *)item->data);
+    item = item->next;
+  }
+
+  UXR_UNLOCK(&wait_set_memory.mutex);
+}
+
+uint32_t rmw_uxrce_io_thread_sequence(
+  rmw_uxrce_wait_set_t * wait_set)
+{
+  pthread_mutex_lock(&wait_set->io_mutex);
+  uint32_t sequence = wait_set->io_sequence;
+  pthread_mutex_unlock(&wait_set->io_mutex);
+
+  return sequence;
+}
+
+int64_t rmw_uxrce_io_thread_now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+bool rmw_uxrce_io_thread_wait(
+  rmw_uxrce_wait_set_t * wait_set,
+  uint32_t sequence,
+  int64_t deadline)
+{
+  struct timespec ts;
+  ts.tv_sec = (time_t)(deadline / 1000000000LL);
+  ts.tv_nsec = (long)(deadline % 1000000000LL);
+
+  bool ready = true;
+
+  pthread_mutex_lock(&wait_set->io_mutex);
+  while (wait_set->io_sequence == sequence) {
+    if (0 > deadline) {
+      pthread_cond_wait(&wait_set->io_cond, &wait_set->io_mutex);
+    } else if (0 != pthread_cond_timedwait(&wait_set->io_cond, &wait_set->io_mutex, &ts)) {
+      ready = wait_set->io_sequence != sequence;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&wait_set->io_mutex);
+
+  return ready;
+}
+
+void rmw_uxrce_io_thread_push_status(
+  rmw_context_impl_t * context,
+  uint16_t request,
+  uint8_t status)
+{
+  // Slots left free by taken replies are reused first, then the oldest reply is evicted
+  size_t slot = 0;
+  for (size_t i = 0; i < RMW_UXRCE_IO_THREAD_STATUS_MAILBOX; i++) {
+    if (UXR_INVALID_REQUEST_ID == context->io_status_requests[i]) {
+      slot = i;
+      break;
+    }
+
+    if (context->io_status_sequence[i] < context->io_status_sequence[slot]) {
+      slot = i;
+    }
+  }
+
+  if (UXR_INVALID_REQUEST_ID != context->io_status_requests[slot]) {
+    // The caller of the evicted request falls back to its own timeout
+    context->io_status_dropped++;
+    RMW_UROS_TRACE_MESSAGE("Session I/O thread status mailbox full, oldest reply dropped")
+  }
+
+  context->io_status_requests[slot] = request;
+  context->io_status[slot] = status;
+  context->io_status_sequence[slot] = context->io_status_next_sequence++;
+}
+
+bool rmw_uxrce_io_thread_take_status(
+  rmw_context_impl_t * context,
+  uint16_t request,
+  uint8_t * status)
+{
+  for (size_t i = 0; UXR_INVALID_REQUEST_ID != request &&
+    i < RMW_UXRCE_IO_THREAD_STATUS_MAILBOX; i++)
+  {
+    if (context->io_status_requests[i] == request) {
+      *status = context->io_status[i];
+      context->io_status_requests[i] = UXR_INVALID_REQUEST_ID;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+#endif  // RMW_UXRCE_IO_THREAD
@@ -24,8 +24,97 @@
 #include <rmw/allocators.h>
 
 #include "./rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/rmw_client.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
+uint16_t buffer_requester_creation(
+  rmw_uxrce_client_t * custom_client)
+{
+  rmw_uxrce_node_t * custom_node = custom_client->owner_node;
+  uint16_t client_req = UXR_INVALID_REQUEST_ID;
+
+#ifdef RMW_UXRCE_USE_REFS
+  // TODO(pablogs9): Use here true references
+  // client_req = uxr_buffer_create_replier_ref(&custom_node->context->session,
+  //     *custom_node->context->creation_stream, custom_service->subscriber_id,
+  //     custom_node->participant_id, "", UXR_REPLACE | UXR_REUSE);
+  char service_name_id[20];
+  generate_name(&custom_client->client_id, service_name_id, sizeof(service_name_id));
+  if (!build_service_xml(
+      service_name_id, custom_client->service_name, true,
+      custom_client->type_support_callbacks, &custom_client->qos,
+      custom_node->context->entity_naming_buffer,
+      sizeof(custom_node->context->entity_naming_buffer)))
+  {
+    RMW_UROS_TRACE_MESSAGE("failed to generate xml request for client creation")
+    return UXR_INVALID_REQUEST_ID;
+  }
+  client_req = uxr_buffer_create_requester_xml(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream,
+    custom_client->client_id,
+    custom_node->participant_id, custom_node->context->entity_naming_buffer,
+    UXR_REPLACE | UXR_REUSE);
+#else
+  char req_type_name[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
+  char res_type_name[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
+  if (!generate_service_types(
+      custom_client->type_support_callbacks, req_type_name, res_type_name,
+      RMW_UXRCE_TYPE_NAME_MAX_LENGTH))
+  {
+    RMW_UROS_TRACE_MESSAGE("Not enough memory for service type names")
+    return UXR_INVALID_REQUEST_ID;
+  }
+
+  char req_topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
+  char res_topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
+  if (!generate_service_topics(
+      custom_client->service_name, req_topic_name, res_topic_name,
+      RMW_UXRCE_TOPIC_NAME_MAX_LENGTH))
+  {
+    RMW_UROS_TRACE_MESSAGE("Not enough memory for service topic names")
+    return UXR_INVALID_REQUEST_ID;
+  }
+
+  client_req = uxr_buffer_create_requester_bin(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream,
+    custom_client->client_id,
+    custom_node->participant_id,
+    (char *) custom_client->service_name,
+    req_type_name,
+    res_type_name,
+    req_topic_name,
+    res_topic_name,
+    convert_qos_profile(&custom_client->qos),
+    UXR_REPLACE | UXR_REUSE);
+#endif /* ifdef RMW_UXRCE_USE_XML */
+
+  return client_req;
+}
+
+uint16_t buffer_client_data_request(
+  rmw_uxrce_client_t * custom_client)
+{
+  rmw_uxrce_node_t * custom_node = custom_client->owner_node;
+
+  uxrDeliveryControl delivery_control;
+  delivery_control.max_samples = UXR_MAX_SAMPLES_UNLIMITED;
+  delivery_control.min_pace_period = 0;
+  delivery_control.max_elapsed_time = UXR_MAX_ELAPSED_TIME_UNLIMITED;
+  delivery_control.max_bytes_per_second = UXR_MAX_BYTES_PER_SECOND_UNLIMITED;
+
+  uxrStreamId data_request_stream_id =
+    (custom_client->qos.reliability == RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT) ?
+    custom_node->context->best_effort_input :
+    custom_node->context->reliable_input;
+
+  return uxr_buffer_request_data(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream, custom_client->client_id,
+    data_request_stream_id, &delivery_control);
+}
+
 rmw_client_t *
 rmw_create_client(
   const rmw_node_t * node,
@@ -54,6 +143,10 @@ rmw_create_client(
     }
     custom_client = (rmw_uxrce_client_t *)memory_node->data;
 
+    custom_client->owner_node = custom_node;
+    rmw_uxrce_init_input_queue(&custom_client->input_queue);
+    custom_client->client_id = uxr_object_id(0, UXR_INVALID_ID);
+
     rmw_client = &custom_client->rmw_client;
     rmw_client->data = custom_client;
     rmw_client->implementation_identifier = rmw_get_implementation_identifier();
@@ -65,7 +158,6 @@ rmw_create_client(
 
     memcpy((void *)rmw_client->service_name, service_name, strlen(service_name) + 1);
 
-    custom_client->owner_node = custom_node;
     custom_client->session_timeout = RMW_UXRCE_PUBLISH_RELIABLE_TIMEOUT;
     custom_client->qos = *qos_policies;
 
@@ -93,97 +185,34 @@ rmw_create_client(
       goto fail;
     }
 
-    custom_client->client_id =
-      uxr_object_id(custom_node->context->id_requester++, UXR_REQUESTER_ID);
-
-    uint16_t client_req = UXR_INVALID_REQUEST_ID;
-
-#ifdef RMW_UXRCE_USE_REFS
-    // TODO(pablogs9): Use here true references
-    // client_req = uxr_buffer_create_replier_ref(&custom_node->context->session,
-    //     *custom_node->context->creation_stream, custom_service->subscriber_id,
-    //     custom_node->participant_id, "", UXR_REPLACE | UXR_REUSE);
-    char service_name_id[20];
-    generate_name(&custom_client->client_id, service_name_id, sizeof(service_name_id));
-    if (!build_service_xml(
-        service_name_id, service_name, true,
-        custom_client->type_support_callbacks, qos_policies, rmw_uxrce_entity_naming_buffer,
-        sizeof(rmw_uxrce_entity_naming_buffer)))
-    {
-      RMW_UROS_TRACE_MESSAGE("failed to generate xml request for client creation")
-      goto fail;
-    }
-    client_req = uxr_buffer_create_requester_xml(
-      &custom_node->context->session,
-      *custom_node->context->creation_stream,
-      custom_client->client_id,
-      custom_node->participant_id, rmw_uxrce_entity_naming_buffer, UXR_REPLACE | UXR_REUSE);
-#else
-    static char req_type_name[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
-    static char res_type_name[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
-    if (!generate_service_types(
-        custom_client->type_support_callbacks, req_type_name, res_type_name,
-        RMW_UXRCE_TYPE_NAME_MAX_LENGTH))
+    if (!acquire_xrce_object_id(
+        custom_node->context, UXR_REQUESTER_ID, &custom_client->client_id))
     {
-      RMW_UROS_TRACE_MESSAGE("Not enough memory for service type names")
       goto fail;
     }
 
-    static char req_topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
-    static char res_topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
-    if (!generate_service_topics(
-        service_name, req_topic_name, res_topic_name,
-        RMW_UXRCE_TOPIC_NAME_MAX_LENGTH))
-    {
-      RMW_UROS_TRACE_MESSAGE("Not enough memory for service topic names")
-      goto fail;
-    }
+    uint16_t client_req = buffer_requester_creation(custom_client);
 
-    client_req = uxr_buffer_create_requester_bin(
-      &custom_node->context->session,
-      *custom_node->context->creation_stream,
-      custom_client->client_id,
-      custom_node->participant_id,
-      (char *) service_name,
-      req_type_name,
-      res_type_name,
-      req_topic_name,
-      res_topic_name,
-      convert_qos_profile(qos_policies),
-      UXR_REPLACE | UXR_REUSE);
-#endif /* ifdef RMW_UXRCE_USE_XML */
-
-    if (!run_xrce_session(
-        custom_node->context, custom_node->context->creation_stream, client_req,
-        custom_node->context->creation_timeout))
+    if (!run_xrce_creation(
+        custom_node->context, &custom_client->client_id, service_name, client_req))
     {
       goto fail;
     }
 
-    uxrDeliveryControl delivery_control;
-    delivery_control.max_samples = UXR_MAX_SAMPLES_UNLIMITED;
-    delivery_control.min_pace_period = 0;
-    delivery_control.max_elapsed_time = UXR_MAX_ELAPSED_TIME_UNLIMITED;
-    delivery_control.max_bytes_per_second = UXR_MAX_BYTES_PER_SECOND_UNLIMITED;
-
     custom_client->stream_id =
       (qos_policies->reliability == RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT) ?
       custom_node->context->best_effort_output :
       custom_node->context->reliable_output;
 
-    uxrStreamId data_request_stream_id =
-      (qos_policies->reliability == RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT) ?
-      custom_node->context->best_effort_input :
-      custom_node->context->reliable_input;
-
-    custom_client->client_data_request = uxr_buffer_request_data(
-      &custom_node->context->session,
-      *custom_node->context->creation_stream, custom_client->client_id,
-      data_request_stream_id, &delivery_control);
+    custom_client->client_data_request = buffer_client_data_request(custom_client);
   }
   return rmw_client;
 
 fail:
+  if (custom_client != NULL) {
+    release_xrce_object_id(custom_client->owner_node->context, &custom_client->client_id);
+  }
+
   rmw_uxrce_fini_client_memory(rmw_client);
   rmw_client = NULL;
   return rmw_client;
@@ -217,24 +246,8 @@ rmw_destroy_client(
     rmw_uxrce_node_t * custom_node = (rmw_uxrce_node_t *)node->data;
     rmw_uxrce_client_t * custom_client = (rmw_uxrce_client_t *)client->data;
 
-    uint16_t client_req = uxr_buffer_cancel_data(
-      &custom_node->context->session,
-      *custom_node->context->destroy_stream,
-      custom_client->client_id);
-
-    run_xrce_session(
-      custom_node->context, custom_node->context->destroy_stream, client_req,
-      custom_node->context->destroy_timeout);
-
-    uint16_t delete_client =
-      uxr_buffer_delete_entity(
-      &custom_node->context->session,
-      *custom_node->context->destroy_stream,
-      custom_client->client_id);
-
-    if (!run_xrce_session(
-        custom_node->context, custom_node->context->destroy_stream, delete_client,
-        custom_node->context->destroy_timeout))
+    if (!run_xrce_deletion(
+        custom_node->context, true, &custom_client->client_id, 1))
     {
       result_ret = RMW_RET_TIMEOUT;
     }
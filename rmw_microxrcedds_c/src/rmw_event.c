@@ -13,20 +13,207 @@
 // limitations under the License.
 
 #include <rmw/event.h>
+#include <rmw/time.h>
+#include <uxr/client/util/time.h>
+#include <rmw_microxrcedds_c/rmw_c_macros.h>
 
+#include "./rmw_microros_internal/rmw_event.h"
+#include "./rmw_microros_internal/identifiers.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
+void rmw_uxrce_init_event_status(
+  rmw_uxrce_event_status_t * status)
+{
+  status->total_count = 0;
+  status->total_count_change = 0;
+  status->callback = NULL;
+  status->user_data = NULL;
+}
+
+// Returns the deadline period in nanoseconds, or 0 if the deadline is not set
+static int64_t rmw_uxrce_deadline_period(
+  const rmw_qos_profile_t * qos)
+{
+  if (rmw_time_equal(qos->deadline, (rmw_time_t)RMW_DURATION_UNSPECIFIED) ||
+    rmw_time_equal(qos->deadline, (rmw_time_t)RMW_DURATION_INFINITE))
+  {
+    return 0;
+  }
+
+  return (int64_t)rmw_time_total_nsec(qos->deadline);
+}
+
+// Accounts the deadline periods elapsed without samples and returns the time until
+// the next expiration, or -1 if there is no deadline
+static int64_t rmw_uxrce_update_deadline(
+  rmw_uxrce_event_status_t * status,
+  int64_t * deadline_start,
+  const rmw_qos_profile_t * qos,
+  size_t * missed)
+{
+  int64_t period = rmw_uxrce_deadline_period(qos);
+  *missed = 0;
+
+  if (0 >= period) {
+    return -1;
+  }
+
+  int64_t now = uxr_nanos();
+  int64_t elapsed = now - *deadline_start;
+
+  if (elapsed >= period) {
+    int64_t periods = elapsed / period;
+    *missed = (size_t)periods;
+    *deadline_start += periods * period;
+    status->total_count += *missed;
+    status->total_count_change += *missed;
+  }
+
+  return *deadline_start + period - now;
+}
+
+static void rmw_uxrce_event_notify(
+  rmw_event_callback_t callback,
+  const void * user_data,
+  size_t count)
+{
+  if (NULL != callback && 0 < count) {
+    callback(user_data, count);
+  }
+}
+
+void rmw_uxrce_subscription_message_lost(
+  rmw_uxrce_subscription_t * subscription)
+{
+  UXR_LOCK(&subscription->input_queue.mutex);
+  subscription->message_lost.total_count++;
+  subscription->message_lost.total_count_change++;
+  rmw_event_callback_t callback = subscription->message_lost.callback;
+  const void * user_data = subscription->message_lost.user_data;
+  UXR_UNLOCK(&subscription->input_queue.mutex);
+
+  rmw_uxrce_event_notify(callback, user_data, 1);
+}
+
+// Periods missed before the sample are accounted first, otherwise restarting the deadline
+// would hide them from the events that are not waited on
+void rmw_uxrce_subscription_sample_received(
+  rmw_uxrce_subscription_t * subscription)
+{
+  size_t missed = 0;
+
+  UXR_LOCK(&subscription->input_queue.mutex);
+  rmw_uxrce_update_deadline(
+    &subscription->deadline_missed, &subscription->deadline_start,
+    &subscription->qos, &missed);
+  subscription->deadline_start = uxr_nanos();
+  rmw_event_callback_t callback = subscription->deadline_missed.callback;
+  const void * user_data = subscription->deadline_missed.user_data;
+  UXR_UNLOCK(&subscription->input_queue.mutex);
+
+  rmw_uxrce_event_notify(callback, user_data, missed);
+}
+
+void rmw_uxrce_publisher_sample_published(
+  rmw_uxrce_publisher_t * publisher)
+{
+  size_t missed = 0;
+
+  UXR_LOCK(&publisher->mutex);
+  rmw_uxrce_update_deadline(
+    &publisher->deadline_missed, &publisher->deadline_start,
+    &publisher->qos, &missed);
+  publisher->deadline_start = uxr_nanos();
+  rmw_event_callback_t callback = publisher->deadline_missed.callback;
+  const void * user_data = publisher->deadline_missed.user_data;
+  UXR_UNLOCK(&publisher->mutex);
+
+  rmw_uxrce_event_notify(callback, user_data, missed);
+}
+
+bool rmw_uxrce_event_is_ready(
+  const rmw_event_t * event,
+  int64_t * next_expiration)
+{
+  bool ready = false;
+  int64_t expiration = -1;
+  size_t missed = 0;
+  rmw_event_callback_t callback = NULL;
+  const void * user_data = NULL;
+
+  switch (event->event_type) {
+    case RMW_EVENT_MESSAGE_LOST:
+      {
+        rmw_uxrce_subscription_t * custom_subscription =
+          (rmw_uxrce_subscription_t *)event->data;
+        UXR_LOCK(&custom_subscription->input_queue.mutex);
+        ready = 0 < custom_subscription->message_lost.total_count_change;
+        UXR_UNLOCK(&custom_subscription->input_queue.mutex);
+        break;
+      }
+    case RMW_EVENT_REQUESTED_DEADLINE_MISSED:
+      {
+        rmw_uxrce_subscription_t * custom_subscription =
+          (rmw_uxrce_subscription_t *)event->data;
+        UXR_LOCK(&custom_subscription->input_queue.mutex);
+        expiration = rmw_uxrce_update_deadline(
+          &custom_subscription->deadline_missed, &custom_subscription->deadline_start,
+          &custom_subscription->qos, &missed);
+        ready = 0 < custom_subscription->deadline_missed.total_count_change;
+        callback = custom_subscription->deadline_missed.callback;
+        user_data = custom_subscription->deadline_missed.user_data;
+        UXR_UNLOCK(&custom_subscription->input_queue.mutex);
+        break;
+      }
+    case RMW_EVENT_OFFERED_DEADLINE_MISSED:
+      {
+        rmw_uxrce_publisher_t * custom_publisher = (rmw_uxrce_publisher_t *)event->data;
+        UXR_LOCK(&custom_publisher->mutex);
+        expiration = rmw_uxrce_update_deadline(
+          &custom_publisher->deadline_missed, &custom_publisher->deadline_start,
+          &custom_publisher->qos, &missed);
+        ready = 0 < custom_publisher->deadline_missed.total_count_change;
+        callback = custom_publisher->deadline_missed.callback;
+        user_data = custom_publisher->deadline_missed.user_data;
+        UXR_UNLOCK(&custom_publisher->mutex);
+        break;
+      }
+    default:
+      break;
+  }
+
+  // Deadlines are also checked on each sample, the callbacks are called once per detection
+  rmw_uxrce_event_notify(callback, user_data, missed);
+
+  if (NULL != next_expiration) {
+    *next_expiration = expiration;
+  }
+
+  return ready;
+}
+
 rmw_ret_t
 rmw_publisher_event_init(
   rmw_event_t * rmw_event,
   const rmw_publisher_t * publisher,
   rmw_event_type_t event_type)
 {
-  (void)rmw_event;
-  (void)publisher;
-  (void)event_type;
-  RMW_UROS_TRACE_MESSAGE("function not implemented")
-  return RMW_RET_UNSUPPORTED;
+  RMW_CHECK_ARGUMENT_FOR_NULL(rmw_event, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    publisher->implementation_identifier,
+    RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+  if (RMW_EVENT_OFFERED_DEADLINE_MISSED != event_type) {
+    RMW_UROS_TRACE_MESSAGE("publisher event type not supported")
+    return RMW_RET_UNSUPPORTED;
+  }
+
+  rmw_event->implementation_identifier = eprosima_microxrcedds_identifier;
+  rmw_event->data = publisher->data;
+  rmw_event->event_type = event_type;
+
+  return RMW_RET_OK;
 }
 
 rmw_ret_t
@@ -35,9 +222,22 @@ rmw_subscription_event_init(
   const rmw_subscription_t * subscription,
   rmw_event_type_t event_type)
 {
-  (void)rmw_event;
-  (void)subscription;
-  (void)event_type;
-  RMW_UROS_TRACE_MESSAGE("function not implemented")
-  return RMW_RET_UNSUPPORTED;
+  RMW_CHECK_ARGUMENT_FOR_NULL(rmw_event, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    subscription->implementation_identifier,
+    RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+  if (RMW_EVENT_MESSAGE_LOST != event_type &&
+    RMW_EVENT_REQUESTED_DEADLINE_MISSED != event_type)
+  {
+    RMW_UROS_TRACE_MESSAGE("subscription event type not supported")
+    return RMW_RET_UNSUPPORTED;
+  }
+
+  rmw_event->implementation_identifier = eprosima_microxrcedds_identifier;
+  rmw_event->data = subscription->data;
+  rmw_event->event_type = event_type;
+
+  return RMW_RET_OK;
 }
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include <rmw/rmw.h>
+#include <rmw_microxrcedds_c/rmw_c_macros.h>
+
+#include "./rmw_microros_internal/types.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
 rmw_ret_t
@@ -63,10 +66,59 @@ rmw_event_set_callback(
   rmw_event_callback_t callback,
   const void * user_data)
 {
-  (void) event;
-  (void) callback;
-  (void) user_data;
+  RMW_CHECK_ARGUMENT_FOR_NULL(event, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    event->implementation_identifier,
+    RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
 
-  RMW_UROS_TRACE_MESSAGE("function not implemented");
-  return RMW_RET_UNSUPPORTED;
+  rmw_uxrce_event_status_t * status = NULL;
+  rmw_uxrce_input_queue_t * queue = NULL;
+  rmw_uxrce_publisher_t * publisher = NULL;
+
+  switch (event->event_type) {
+    case RMW_EVENT_MESSAGE_LOST:
+      {
+        rmw_uxrce_subscription_t * custom_subscription =
+          (rmw_uxrce_subscription_t *)event->data;
+        status = &custom_subscription->message_lost;
+        queue = &custom_subscription->input_queue;
+        break;
+      }
+    case RMW_EVENT_REQUESTED_DEADLINE_MISSED:
+      {
+        rmw_uxrce_subscription_t * custom_subscription =
+          (rmw_uxrce_subscription_t *)event->data;
+        status = &custom_subscription->deadline_missed;
+        queue = &custom_subscription->input_queue;
+        break;
+      }
+    case RMW_EVENT_OFFERED_DEADLINE_MISSED:
+      publisher = (rmw_uxrce_publisher_t *)event->data;
+      status = &publisher->deadline_missed;
+      break;
+    default:
+      RMW_UROS_TRACE_MESSAGE("event type not supported")
+      return RMW_RET_UNSUPPORTED;
+  }
+
+  if (NULL != queue) {
+    UXR_LOCK(&queue->mutex);
+  } else {
+    UXR_LOCK(&publisher->mutex);
+  }
+  status->callback = callback;
+  status->user_data = user_data;
+  size_t unread_events = status->total_count_change;
+  if (NULL != queue) {
+    UXR_UNLOCK(&queue->mutex);
+  } else {
+    UXR_UNLOCK(&publisher->mutex);
+  }
+
+  // Events that happened before the callback was set are notified at once
+  if (NULL != callback && 0 < unread_events) {
+    callback(user_data, unread_events);
+  }
+
+  return RMW_RET_OK;
 }
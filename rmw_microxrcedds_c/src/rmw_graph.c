@@ -35,9 +35,22 @@ rmw_ret_t rmw_graph_init(
   graph_info->has_changed = false;
   graph_info->context = context;
 
+  graph_info->participant_id = uxr_object_id(0, UXR_INVALID_ID);
+  graph_info->subscriber_id = uxr_object_id(0, UXR_INVALID_ID);
+  graph_info->datareader_id = uxr_object_id(0, UXR_INVALID_ID);
+  graph_info->topic_id = uxr_object_id(0, UXR_INVALID_ID);
+
+  if (!acquire_xrce_object_id(context, UXR_PARTICIPANT_ID, &graph_info->participant_id) ||
+    !acquire_xrce_object_id(context, UXR_SUBSCRIBER_ID, &graph_info->subscriber_id) ||
+    !acquire_xrce_object_id(context, UXR_DATAREADER_ID, &graph_info->datareader_id) ||
+    !acquire_xrce_object_id(context, UXR_TOPIC_ID, &graph_info->topic_id))
+  {
+    RMW_UROS_TRACE_MESSAGE("Cannot allocate object ids for graph entities")
+    ret = RMW_RET_ERROR;
+    goto end;
+  }
+
   // Create micro-ROS graph participant
-  graph_info->participant_id =
-    uxr_object_id(context->id_participant++, UXR_PARTICIPANT_ID);
   size_t microros_domain_id = 0;  // TODO(jamoralp): shall this Domain ID be configurabe, user wise?
   const char * graph_participant_name = "microros_graph";
 
@@ -65,12 +78,11 @@ rmw_ret_t rmw_graph_init(
   };
 
   // Create graph subscriber requests
-  graph_info->subscriber_id = uxr_object_id(context->id_subscriber++, UXR_SUBSCRIBER_ID);
   char subscriber_name[20];
   generate_name(&graph_info->subscriber_id, subscriber_name, sizeof(subscriber_name));
   if (!build_subscriber_xml(
-      subscriber_name, rmw_uxrce_entity_naming_buffer,
-      sizeof(rmw_uxrce_entity_naming_buffer)))
+      subscriber_name, context->entity_naming_buffer,
+      sizeof(context->entity_naming_buffer)))
   {
     RMW_UROS_TRACE_MESSAGE("Failed to generate xml request for graph subscriber creation")
     ret = RMW_RET_ERROR;
@@ -79,20 +91,18 @@ rmw_ret_t rmw_graph_init(
 
   uint16_t subscriber_req = uxr_buffer_create_subscriber_xml(
     &context->session, *context->creation_stream, graph_info->subscriber_id,
-    graph_info->participant_id, rmw_uxrce_entity_naming_buffer, UXR_REPLACE | UXR_REUSE);
+    graph_info->participant_id, context->entity_naming_buffer, UXR_REPLACE | UXR_REUSE);
 
-  graph_info->datareader_id = uxr_object_id(context->id_datareader++, UXR_DATAREADER_ID);
   const char * graph_topic_name = "ros_to_microros_graph";
   graph_info->graph_type_support =
     rosidl_typesupport_microxrcedds_c__get_message_type_support_handle__micro_ros_msgs__msg__Graph(); //NOLINT
 
   // Create graph topic request
-  graph_info->topic_id = uxr_object_id(context->id_topic++, UXR_TOPIC_ID);
   if (!build_topic_xml(
       graph_topic_name,
       (message_type_support_callbacks_t *)(graph_info->graph_type_support->data),
-      &graph_subscription_qos_policies, rmw_uxrce_entity_naming_buffer,
-      sizeof(rmw_uxrce_entity_naming_buffer)))
+      &graph_subscription_qos_policies, context->entity_naming_buffer,
+      sizeof(context->entity_naming_buffer)))
   {
     RMW_UROS_TRACE_MESSAGE("Failed to generate xml request for graph topic creation")
     ret = RMW_RET_ERROR;
@@ -101,14 +111,14 @@ rmw_ret_t rmw_graph_init(
 
   uint16_t topic_req = uxr_buffer_create_topic_xml(
     &context->session, *context->creation_stream, graph_info->topic_id,
-    graph_info->participant_id, rmw_uxrce_entity_naming_buffer, UXR_REPLACE | UXR_REUSE);
+    graph_info->participant_id, context->entity_naming_buffer, UXR_REPLACE | UXR_REUSE);
 
   // Create graph datareader request
   if (!build_datareader_xml(
       graph_topic_name,
       (message_type_support_callbacks_t *)(graph_info->graph_type_support->data),
-      &graph_subscription_qos_policies, rmw_uxrce_entity_naming_buffer,
-      sizeof(rmw_uxrce_entity_naming_buffer)))
+      &graph_subscription_qos_policies, context->entity_naming_buffer,
+      sizeof(context->entity_naming_buffer)))
   {
     RMW_UROS_TRACE_MESSAGE("Failed to generate xml request for graph datareader creation")
     ret = RMW_RET_ERROR;
@@ -117,7 +127,7 @@ rmw_ret_t rmw_graph_init(
 
   uint16_t datareader_req = uxr_buffer_create_datareader_xml(
     &context->session, *context->creation_stream, graph_info->datareader_id,
-    graph_info->subscriber_id, rmw_uxrce_entity_naming_buffer, UXR_REPLACE | UXR_REUSE);
+    graph_info->subscriber_id, context->entity_naming_buffer, UXR_REPLACE | UXR_REUSE);
 
   // Run session
   uint16_t requests[] = {
@@ -125,8 +135,8 @@ rmw_ret_t rmw_graph_init(
   };
   uint8_t status[sizeof(requests) / 2];
 
-  if (!uxr_run_session_until_all_status(
-      &context->session, 1000, requests, status, sizeof(status)))
+  if (!run_xrce_session_until_all_status(
+      context, 1000, requests, status, sizeof(status)))
   {
     RMW_UROS_TRACE_MESSAGE("Issues creating Micro XRCE-DDS graph related entities")
     ret = RMW_RET_ERROR;
@@ -146,6 +156,12 @@ rmw_ret_t rmw_graph_init(
     context->reliable_input, &delivery_control);
 
 end:
+  if (RMW_RET_OK != ret) {
+    release_xrce_object_id(context, &graph_info->participant_id);
+    release_xrce_object_id(context, &graph_info->subscriber_id);
+    release_xrce_object_id(context, &graph_info->datareader_id);
+    release_xrce_object_id(context, &graph_info->topic_id);
+  }
   return ret;
 }
 
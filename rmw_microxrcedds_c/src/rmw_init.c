@@ -24,6 +24,7 @@
 #include "./rmw_microros_internal/callbacks.h"
 #include "./rmw_microros_internal/types.h"
 #include "./rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/io_thread.h"
 #include "./rmw_microros_internal/rmw_node.h"
 #include "./rmw_microros_internal/identifiers.h"
 #include "./rmw_microros_internal/rmw_uxrce_transports.h"
@@ -33,6 +34,10 @@
 #include "./rmw_microros_internal/rmw_graph.h"
 #endif  // RMW_UXRCE_GRAPH
 
+#if UXR_CONFIG_MAX_OUTPUT_RELIABLE_STREAMS < RMW_UXRCE_PRIORITY_CLASSES
+#error RMW_UXRCE_PRIORITY_CLASSES requires as many output reliable streams in the XRCE-DDS Client
+#endif
+
 extern rmw_uxrce_transport_params_t rmw_uxrce_transport_default_params;
 
 rmw_ret_t
@@ -109,6 +114,8 @@ rmw_init_options_init(
   init_options->impl->transport_params.read_cb = rmw_uxrce_transport_default_params.read_cb;
 #endif /* if defined(RMW_UXRCE_TRANSPORT_SERIAL) */
 
+  init_options->impl->session_store = NULL;
+
   srand(uxr_nanos());
 
   do {
@@ -146,6 +153,7 @@ rmw_init_options_copy(
   rmw_uxrce_init_options_impl_t * src_impl = src->impl;
 
   dst_impl->transport_params = src_impl->transport_params;
+  dst_impl->session_store = src_impl->session_store;
 
   return RMW_RET_OK;
 }
@@ -198,9 +206,13 @@ rmw_init(
   context->actual_domain_id = options->domain_id;
 
 #ifdef UCLIENT_PROFILE_MULTITHREAD
-  if (!rmw_uxrce_wait_mutex_initialized) {
-    UXR_INIT_LOCK(&rmw_uxrce_wait_mutex);
-    rmw_uxrce_wait_mutex_initialized = true;
+  if (!rmw_uxrce_name_cache_mutex_initialized) {
+    UXR_INIT_LOCK(&rmw_uxrce_name_cache_mutex);
+    rmw_uxrce_name_cache_mutex_initialized = true;
+  }
+  if (!rmw_uxrce_wakeup_callback_mutex_initialized) {
+    UXR_INIT_LOCK(&rmw_uxrce_wakeup_callback_mutex);
+    rmw_uxrce_wakeup_callback_mutex_initialized = true;
   }
 #endif  // UCLIENT_PROFILE_MULTITHREAD
 
@@ -209,6 +221,24 @@ rmw_init(
     &static_buffer_memory, custom_static_buffers,
     RMW_UXRCE_MAX_HISTORY);
   static_buffer_memory.is_dynamic_allowed = false;
+#if RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+  rmw_uxrce_init_large_input_buffer_memory(
+    &large_input_buffer_memory, custom_large_input_buffers,
+    RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS);
+  large_input_buffer_memory.is_dynamic_allowed = false;
+#endif  // RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+#if RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+  rmw_uxrce_init_publisher_allocation_memory(
+    &publisher_allocation_memory, custom_publisher_allocations,
+    RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS);
+  publisher_allocation_memory.is_dynamic_allowed = false;
+#endif  // RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+#if RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+  rmw_uxrce_init_subscription_allocation_memory(
+    &subscription_allocation_memory, custom_subscription_allocations,
+    RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS);
+  subscription_allocation_memory.is_dynamic_allowed = false;
+#endif  // RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
 
   rmw_uxrce_mempool_item_t * memory_node = get_memory(&session_memory);
   if (!memory_node) {
@@ -219,6 +249,14 @@ rmw_init(
 
   rmw_context_impl_t * context_impl = (rmw_context_impl_t *)memory_node->data;
 
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+  // Session slots are zero initialized and reused, so their mutex is only created once
+  if (!context_impl->wait_mutex_initialized) {
+    UXR_INIT_LOCK(&context_impl->wait_mutex);
+    context_impl->wait_mutex_initialized = true;
+  }
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+
   #if defined(RMW_UXRCE_TRANSPORT_CUSTOM)
   uxr_set_custom_transport_callbacks(
     &context_impl->transport,
@@ -231,6 +269,7 @@ rmw_init(
 
   context_impl->creation_timeout = RMW_UXRCE_ENTITY_CREATION_TIMEOUT;
   context_impl->destroy_timeout = RMW_UXRCE_ENTITY_DESTROY_TIMEOUT;
+  context_impl->session_teardown = false;
 
   context_impl->creation_stream = (RMW_UXRCE_ENTITY_CREATION_TIMEOUT > 0) ?
     &context_impl->reliable_output :
@@ -240,14 +279,30 @@ rmw_init(
     &context_impl->reliable_output :
     &context_impl->best_effort_output;
 
-  context_impl->id_participant = 0;
-  context_impl->id_topic = 0;
-  context_impl->id_publisher = 0;
-  context_impl->id_datawriter = 0;
-  context_impl->id_subscriber = 0;
-  context_impl->id_datareader = 0;
-  context_impl->id_requester = 0;
-  context_impl->id_replier = 0;
+  init_xrce_object_ids(context_impl);
+
+  uint32_t client_key = options->impl->transport_params.client_key;
+
+  context_impl->session_store = options->impl->session_store;
+  context_impl->topology_hash = RMW_UXRCE_TOPOLOGY_HASH_SEED;
+  context_impl->topology_entities = 0;
+  context_impl->resume_requests_count = 0;
+  context_impl->resume_failed = false;
+
+#ifdef RMW_UXRCE_IO_THREAD
+  for (size_t i = 0; i < RMW_UXRCE_IO_THREAD_STATUS_MAILBOX; i++) {
+    context_impl->io_status_requests[i] = UXR_INVALID_REQUEST_ID;
+    context_impl->io_status_sequence[i] = 0;
+  }
+  context_impl->io_status_next_sequence = 0;
+  context_impl->io_status_dropped = 0;
+#endif  // RMW_UXRCE_IO_THREAD
+  context_impl->resuming = rmw_uros_session_store_is_valid(context_impl->session_store) &&
+    0 < context_impl->session_store->entity_count;
+
+  if (context_impl->resuming) {
+    client_key = context_impl->session_store->client_key;
+  }
 
   context_impl->graph_guard_condition.implementation_identifier = eprosima_microxrcedds_identifier;
   context_impl->graph_guard_condition.data = NULL;
@@ -283,10 +338,10 @@ rmw_init(
 
   uxr_init_session(
     &context_impl->session, &context_impl->transport.comm,
-    options->impl->transport_params.client_key);
+    client_key);
 
   uxr_set_topic_callback(&context_impl->session, on_topic, (void *)(context_impl));
-  uxr_set_status_callback(&context_impl->session, on_status, NULL);
+  uxr_set_status_callback(&context_impl->session, on_status, (void *)(context_impl));
   uxr_set_request_callback(&context_impl->session, on_request, NULL);
   uxr_set_reply_callback(&context_impl->session, on_reply, NULL);
 
@@ -300,6 +355,26 @@ rmw_init(
     context_impl->transport.comm.mtu * RMW_UXRCE_STREAM_HISTORY_OUTPUT,
     RMW_UXRCE_STREAM_HISTORY_OUTPUT);
 
+#if RMW_UXRCE_PRIORITY_CLASSES > 1
+  // Output streams are flushed in creation order, so higher priority classes are created first
+  for (size_t i = 0; i < RMW_UXRCE_PRIORITY_CLASSES - 1; i++) {
+    context_impl->priority_reliable_output[i] =
+      uxr_create_output_reliable_stream(
+      &context_impl->session, context_impl->priority_reliable_stream_buffer[i],
+      context_impl->transport.comm.mtu * RMW_UXRCE_STREAM_HISTORY_OUTPUT,
+      RMW_UXRCE_STREAM_HISTORY_OUTPUT);
+  }
+#endif  // RMW_UXRCE_PRIORITY_CLASSES > 1
+
+#ifdef RMW_UXRCE_FRAGMENT_STREAM
+  // Created last, best effort fragments never delay the reliable publishers
+  context_impl->fragment_output =
+    uxr_create_output_reliable_stream(
+    &context_impl->session, context_impl->fragment_stream_buffer,
+    context_impl->transport.comm.mtu * RMW_UXRCE_STREAM_HISTORY_OUTPUT,
+    RMW_UXRCE_STREAM_HISTORY_OUTPUT);
+#endif  // RMW_UXRCE_FRAGMENT_STREAM
+
   context_impl->best_effort_input = uxr_create_input_best_effort_stream(&context_impl->session);
   context_impl->best_effort_output = uxr_create_output_best_effort_stream(
     &context_impl->session,
@@ -313,14 +388,36 @@ rmw_init(
     return RMW_RET_ERROR;
   }
 
+  if (NULL != context_impl->session_store && !context_impl->resuming) {
+    context_impl->session_store->magic = RMW_UROS_SESSION_STORE_MAGIC;
+    context_impl->session_store->client_key = client_key;
+    context_impl->session_store->topology_hash = context_impl->topology_hash;
+    context_impl->session_store->entity_count = 0;
+  }
+
 #ifdef RMW_UXRCE_GRAPH
   // Create graph manager information
   if (RMW_RET_OK != rmw_graph_init(context_impl, &context_impl->graph_info)) {
     uxr_delete_session(&context_impl->session);
+    CLOSE_TRANSPORT(&context_impl->transport);
+    put_memory(&session_memory, &context_impl->mem);
+    context->impl = NULL;
     return RMW_RET_ERROR;
   }
 #endif  // RMW_UXRCE_GRAPH
 
+#ifdef RMW_UXRCE_IO_THREAD
+  // From now on the session is only spun by its I/O thread and rmw_wait
+  // waits for its notifications
+  if (!rmw_uxrce_io_thread_start(context_impl)) {
+    uxr_delete_session(&context_impl->session);
+    CLOSE_TRANSPORT(&context_impl->transport);
+    put_memory(&session_memory, &context_impl->mem);
+    context->impl = NULL;
+    return RMW_RET_ERROR;
+  }
+#endif  // RMW_UXRCE_IO_THREAD
+
   return RMW_RET_OK;
 }
 
@@ -333,18 +430,49 @@ rmw_shutdown(
     context->implementation_identifier,
     RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
 
+  rmw_context_impl_t * context_impl = context->impl;
+
+#ifdef RMW_UXRCE_IO_THREAD
+  // The I/O thread fills the input queues, it is stopped before they are cleared
+  // even if rmw_context_fini fails
+  if (NULL != context_impl) {
+    rmw_uxrce_io_thread_stop(context_impl);
+  }
+#endif  // RMW_UXRCE_IO_THREAD
+
   rmw_ret_t ret = rmw_context_fini(context);
 
   if (RMW_RET_OK == ret) {
     *context = rmw_get_zero_initialized_context();
   }
 
-  rmw_uxrce_mempool_item_t * item = static_buffer_memory.allocateditems;
+  // Drop the samples buffered for the entities of this context that could not be destroyed.
+  // Entities of other contexts keep theirs, their I/O threads are still running.
+  rmw_uxrce_mempool_item_t * item = subscription_memory.allocateditems;
+  while (item != NULL) {
+    rmw_uxrce_subscription_t * custom_subscription = (rmw_uxrce_subscription_t *)item->data;
+    if (custom_subscription->owner_node->context == context_impl) {
+      rmw_uxrce_input_queue_clear(&custom_subscription->input_queue);
+    }
+    item = item->next;
+  }
 
+  item = service_memory.allocateditems;
   while (item != NULL) {
-    rmw_uxrce_mempool_item_t * aux_next = item->next;
-    put_memory(&static_buffer_memory, item);
-    item = aux_next;
+    rmw_uxrce_service_t * custom_service = (rmw_uxrce_service_t *)item->data;
+    if (custom_service->owner_node->context == context_impl) {
+      rmw_uxrce_input_queue_clear(&custom_service->input_queue);
+    }
+    item = item->next;
+  }
+
+  item = client_memory.allocateditems;
+  while (item != NULL) {
+    rmw_uxrce_client_t * custom_client = (rmw_uxrce_client_t *)item->data;
+    if (custom_client->owner_node->context == context_impl) {
+      rmw_uxrce_input_queue_clear(&custom_client->input_queue);
+    }
+    item = item->next;
   }
 
   return ret;
@@ -356,6 +484,26 @@ rmw_context_fini(
 {
   rmw_ret_t ret = RMW_RET_OK;
 
+#ifdef RMW_UXRCE_IO_THREAD
+  // Entities cannot be released while the I/O thread fills their buffers
+  if (NULL != context->impl) {
+    rmw_uxrce_io_thread_stop(context->impl);
+  }
+#endif  // RMW_UXRCE_IO_THREAD
+
+  bool entities_deleted = true;
+
+  if (NULL != context->impl) {
+#ifdef RMW_UXRCE_SESSION_TEARDOWN
+    // Deleting the session removes all its entities on the Agent at once
+#else
+    // All the entities are deleted on the Agent in a few batches instead of one round trip each
+    entities_deleted = run_xrce_context_deletion(context->impl);
+#endif  // RMW_UXRCE_SESSION_TEARDOWN
+    // The nodes are then only destroyed locally
+    context->impl->session_teardown = true;
+  }
+
   rmw_uxrce_mempool_item_t * item = node_memory.allocateditems;
 
   while (item != NULL) {
@@ -366,6 +514,10 @@ rmw_context_fini(
     }
   }
 
+  if (RMW_RET_OK == ret && !entities_deleted) {
+    ret = RMW_RET_TIMEOUT;
+  }
+
   if (NULL != context->impl) {
     size_t retries = UXR_CONFIG_MAX_SESSION_CONNECTION_ATTEMPTS;
 
@@ -374,6 +526,10 @@ rmw_context_fini(
       retries = 0;
     }
 
+    if (NULL != context_impl->session_store) {
+      rmw_uros_session_store_invalidate(context_impl->session_store);
+    }
+
     uxr_delete_session_retries(&context->impl->session, retries);
     rmw_uxrce_fini_session_memory(context->impl);
     CLOSE_TRANSPORT(&context->impl->transport);
@@ -18,6 +18,7 @@
 #include <rmw/ret_types.h>
 
 #include "../rmw_microros_internal/types.h"
+#include "../rmw_microros_internal/wakeup.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
 rmw_uxrce_transport_params_t rmw_uxrce_transport_default_params;
@@ -76,3 +77,11 @@ rmw_ret_t rmw_uros_options_set_custom_transport(
 
   return RMW_RET_OK;
 }
+
+rmw_ret_t rmw_uros_set_custom_transport_wakeup(
+  rmw_uros_custom_transport_wakeup_func wakeup_cb,
+  void * args)
+{
+  rmw_uxrce_wakeup_set_callback(wakeup_cb, args);
+  return RMW_RET_OK;
+}
@@ -0,0 +1,100 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rmw_microxrcedds_c/config.h>
+#include <rmw/rmw.h>
+#include <rmw/error_handling.h>
+#include <rmw/ret_types.h>
+
+#include "../rmw_microros_internal/types.h"
+#include "./rmw_microros_internal/rmw_uxrce_transports.h"
+#include "./rmw_microros_internal/error_handling_internal.h"
+
+// Transport file descriptors are only available on POSIX platforms
+#ifdef UCLIENT_PLATFORM_POSIX
+
+#include <poll.h>
+
+#include <rmw_microros/event_loop.h>
+
+rmw_ret_t rmw_uros_get_context_fd(
+  const rmw_context_t * context,
+  int * fd)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(context->impl, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(fd, RMW_RET_INVALID_ARGUMENT);
+
+#ifdef RMW_UXRCE_IO_THREAD
+  RMW_UROS_TRACE_MESSAGE("Sessions are spun by their I/O thread")
+  return RMW_RET_UNSUPPORTED;
+#else
+  *fd = rmw_uxrce_transport_fd(context->impl);
+  return RMW_RET_OK;
+#endif  // RMW_UXRCE_IO_THREAD
+}
+
+rmw_ret_t rmw_uros_process_ready_io(
+  const rmw_context_t * context)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(context->impl, RMW_RET_INVALID_ARGUMENT);
+
+#ifdef RMW_UXRCE_IO_THREAD
+  RMW_UROS_TRACE_MESSAGE("Sessions are spun by their I/O thread")
+  return RMW_RET_UNSUPPORTED;
+#else
+  rmw_context_impl_t * context_impl = context->impl;
+
+  struct pollfd transport_fd;
+  transport_fd.fd = rmw_uxrce_transport_fd(context_impl);
+  transport_fd.events = POLLIN;
+
+  rmw_ret_t ret = RMW_RET_OK;
+
+  // Serialized with rmw_wait calls on the same session
+  UXR_LOCK(&context_impl->wait_mutex);
+
+  // The framing of stream transports may already hold complete frames that left
+  // nothing to read on the file descriptor, so keep serving the session while it
+  // receives data and only then rely on the descriptor readiness
+  for (;;) {
+    if (uxr_run_session_until_data(&context_impl->session, 0)) {
+      continue;
+    }
+
+    transport_fd.revents = 0;
+    if (0 >= poll(&transport_fd, 1, 0)) {
+      break;
+    }
+
+    // A closed or failed descriptor stays readable, serving it again would never end
+    if (transport_fd.revents & RMW_UXRCE_TRANSPORT_POLL_ERROR) {
+      RMW_UROS_TRACE_MESSAGE("Session transport closed or failed")
+      ret = RMW_RET_ERROR;
+      break;
+    }
+
+    if (!(transport_fd.revents & POLLIN)) {
+      break;
+    }
+  }
+
+  UXR_UNLOCK(&context_impl->wait_mutex);
+
+  return ret;
+#endif  // RMW_UXRCE_IO_THREAD
+}
+
+#endif  // UCLIENT_PLATFORM_POSIX
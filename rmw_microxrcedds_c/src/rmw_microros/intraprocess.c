@@ -0,0 +1,41 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rmw_microxrcedds_c/config.h>
+#include <rmw/rmw.h>
+#include <rmw/error_handling.h>
+#include <rmw/ret_types.h>
+
+#include "../rmw_microros_internal/types.h"
+#include "../rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/error_handling_internal.h"
+
+rmw_ret_t rmw_uros_set_publisher_local_only(
+  rmw_publisher_t * publisher,
+  bool local_only)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+
+  if (!is_uxrce_rmw_identifier_valid(publisher->implementation_identifier) ||
+    NULL == publisher->data)
+  {
+    RMW_UROS_TRACE_MESSAGE("publisher handle not from this implementation")
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  rmw_uxrce_publisher_t * custom_publisher = (rmw_uxrce_publisher_t *)publisher->data;
+  custom_publisher->local_only = local_only;
+
+  return RMW_RET_OK;
+}
@@ -0,0 +1,56 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rmw_microxrcedds_c/config.h>
+#include <rmw/rmw.h>
+#include <rmw/error_handling.h>
+#include <rmw/ret_types.h>
+#include <uxr/client/profile/multithread/multithread.h>
+
+#include "../rmw_microros_internal/types.h"
+#include "../rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/error_handling_internal.h"
+
+rmw_ret_t rmw_uros_set_subscription_large_buffer(
+  rmw_subscription_t * subscription,
+  uint8_t * buffer,
+  size_t size)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+
+  if (!is_uxrce_rmw_identifier_valid(subscription->implementation_identifier) ||
+    NULL == subscription->data)
+  {
+    RMW_UROS_TRACE_MESSAGE("subscription handle not from this implementation")
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  rmw_uxrce_subscription_t * custom_subscription =
+    (rmw_uxrce_subscription_t *)subscription->data;
+  rmw_uxrce_user_input_buffer_t * user_buffer = &custom_subscription->user_buffer;
+
+  rmw_ret_t ret = RMW_RET_OK;
+
+  UXR_LOCK(&static_buffer_memory.mutex);
+  if (user_buffer->in_use) {
+    RMW_UROS_TRACE_MESSAGE("large buffer holds a sample not taken yet")
+    ret = RMW_RET_ERROR;
+  } else {
+    user_buffer->data = buffer;
+    user_buffer->size = (NULL != buffer) ? size : 0;
+  }
+  UXR_UNLOCK(&static_buffer_memory.mutex);
+
+  return ret;
+}
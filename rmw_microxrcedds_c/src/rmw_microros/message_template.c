@@ -0,0 +1,156 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include <rmw_microxrcedds_c/config.h>
+#include <rmw/rmw.h>
+#include <rmw/error_handling.h>
+#include <rmw/ret_types.h>
+
+#include "../rmw_microros_internal/types.h"
+#include "../rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/error_handling_internal.h"
+
+static bool rmw_uxrce_serialize_template(
+  const message_type_support_callbacks_t * functions,
+  const void * ros_message,
+  uint8_t * buffer,
+  size_t buffer_size,
+  size_t * length)
+{
+  ucdrBuffer mb;
+  ucdr_init_buffer(&mb, buffer, buffer_size);
+
+  bool ret = functions->cdr_serialize(ros_message, &mb) && !mb.error;
+  *length = ucdr_buffer_length(&mb);
+
+  return ret;
+}
+
+rmw_ret_t rmw_uros_init_message_template(
+  rmw_uros_message_template_t * message_template,
+  const rmw_publisher_t * publisher,
+  const void * ros_message,
+  uint8_t * buffer,
+  size_t buffer_size)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(message_template, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(buffer, RMW_RET_INVALID_ARGUMENT);
+
+  if (!is_uxrce_rmw_identifier_valid(publisher->implementation_identifier) ||
+    NULL == publisher->data)
+  {
+    RMW_UROS_TRACE_MESSAGE("publisher handle not from this implementation")
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  rmw_uxrce_publisher_t * custom_publisher = (rmw_uxrce_publisher_t *)publisher->data;
+
+  message_template->publisher = publisher;
+  message_template->buffer = buffer;
+  message_template->buffer_size = buffer_size;
+  message_template->length = 0;
+  message_template->field_count = 0;
+
+  size_t length = 0;
+  if (!rmw_uxrce_serialize_template(
+      custom_publisher->type_support_callbacks, ros_message, buffer, buffer_size / 2, &length))
+  {
+    RMW_UROS_TRACE_MESSAGE("message does not fit in the template buffer")
+    return RMW_RET_ERROR;
+  }
+
+  message_template->length = length;
+
+  return RMW_RET_OK;
+}
+
+rmw_ret_t rmw_uros_message_template_add_field(
+  rmw_uros_message_template_t * message_template,
+  void * ros_message,
+  void * field,
+  size_t field_size)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(message_template, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(field, RMW_RET_INVALID_ARGUMENT);
+
+  if (0 == message_template->length || NULL == message_template->publisher) {
+    RMW_UROS_TRACE_MESSAGE("message template not initialized")
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  if ((1 != field_size && 2 != field_size && 4 != field_size && 8 != field_size) ||
+    (uint8_t *)field < (uint8_t *)ros_message)
+  {
+    RMW_UROS_TRACE_MESSAGE("field is not a primitive member of the message")
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  if (message_template->field_count >= RMW_UROS_MESSAGE_TEMPLATE_MAX_FIELDS) {
+    RMW_UROS_TRACE_MESSAGE("message template has no room for more fields")
+    return RMW_RET_ERROR;
+  }
+
+  rmw_uxrce_publisher_t * custom_publisher =
+    (rmw_uxrce_publisher_t *)message_template->publisher->data;
+  uint8_t * field_bytes = (uint8_t *)field;
+  uint8_t backup[8];
+
+  // Every byte of the field changes, so the serialized one can be located by comparison
+  memcpy(backup, field_bytes, field_size);
+  for (size_t i = 0; i < field_size; i++) {
+    field_bytes[i] ^= 0xFF;
+  }
+
+  uint8_t * scratch = &message_template->buffer[message_template->buffer_size / 2];
+  size_t length = 0;
+  bool serialized = rmw_uxrce_serialize_template(
+    custom_publisher->type_support_callbacks, ros_message, scratch,
+    message_template->buffer_size / 2, &length);
+
+  bool found = false;
+  size_t cdr_offset = 0;
+  if (serialized && length == message_template->length) {
+    while (cdr_offset < length && scratch[cdr_offset] == message_template->buffer[cdr_offset]) {
+      cdr_offset++;
+    }
+
+    // The field must be serialized verbatim, patching it is then a plain copy
+    found = cdr_offset + field_size <= length &&
+      0 == memcmp(&scratch[cdr_offset], field_bytes, field_size) &&
+      0 == memcmp(
+      &scratch[cdr_offset + field_size], &message_template->buffer[cdr_offset + field_size],
+      length - cdr_offset - field_size);
+  }
+
+  memcpy(field_bytes, backup, field_size);
+
+  if (!found) {
+    RMW_UROS_TRACE_MESSAGE("field not found in the serialized message")
+    return RMW_RET_ERROR;
+  }
+
+  rmw_uros_message_template_field_t * template_field =
+    &message_template->fields[message_template->field_count];
+  template_field->member_offset = (size_t)(field_bytes - (uint8_t *)ros_message);
+  template_field->cdr_offset = cdr_offset;
+  template_field->size = field_size;
+  message_template->field_count++;
+
+  return RMW_RET_OK;
+}
@@ -0,0 +1,55 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rmw_microxrcedds_c/config.h>
+#include <rmw/rmw.h>
+#include <rmw/error_handling.h>
+#include <rmw/ret_types.h>
+
+#include "../rmw_microros_internal/types.h"
+#include "../rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/error_handling_internal.h"
+
+rmw_ret_t rmw_uros_set_publisher_priority_class(
+  rmw_publisher_t * publisher,
+  uint8_t priority_class)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+
+  if (!is_uxrce_rmw_identifier_valid(publisher->implementation_identifier) ||
+    NULL == publisher->data)
+  {
+    RMW_UROS_TRACE_MESSAGE("publisher handle not from this implementation")
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  if (RMW_UXRCE_PRIORITY_CLASSES <= priority_class) {
+    RMW_UROS_TRACE_MESSAGE("priority class out of range")
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  rmw_uxrce_publisher_t * custom_publisher = (rmw_uxrce_publisher_t *)publisher->data;
+
+  // A concurrent rmw_publish keeps the previous stream until its sample is written
+  UXR_LOCK(&custom_publisher->mutex);
+  custom_publisher->priority_class = priority_class;
+
+  if (UXR_RELIABLE_STREAM == custom_publisher->stream_id.type) {
+    custom_publisher->stream_id = get_priority_reliable_output(
+      custom_publisher->owner_node->context, priority_class);
+  }
+  UXR_UNLOCK(&custom_publisher->mutex);
+
+  return RMW_RET_OK;
+}
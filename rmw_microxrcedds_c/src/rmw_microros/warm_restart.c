@@ -0,0 +1,56 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rmw_microxrcedds_c/config.h>
+#include <rmw/rmw.h>
+#include <rmw/error_handling.h>
+#include <rmw/ret_types.h>
+
+#include "../rmw_microros_internal/types.h"
+#include "./rmw_microros_internal/error_handling_internal.h"
+
+rmw_ret_t rmw_uros_options_set_session_store(
+  rmw_uros_session_store_t * store,
+  rmw_init_options_t * rmw_options)
+{
+  if (NULL == rmw_options || NULL == rmw_options->impl) {
+    RMW_UROS_TRACE_MESSAGE("Uninitialised rmw_init_options.")
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  rmw_options->impl->session_store = store;
+
+  return RMW_RET_OK;
+}
+
+bool rmw_uros_session_store_is_valid(
+  const rmw_uros_session_store_t * store)
+{
+  return NULL != store &&
+         RMW_UROS_SESSION_STORE_MAGIC == store->magic &&
+         0 != store->client_key;
+}
+
+rmw_ret_t rmw_uros_session_store_invalidate(
+  rmw_uros_session_store_t * store)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(store, RMW_RET_INVALID_ARGUMENT);
+
+  store->magic = 0;
+  store->client_key = 0;
+  store->topology_hash = 0;
+  store->entity_count = 0;
+
+  return RMW_RET_OK;
+}
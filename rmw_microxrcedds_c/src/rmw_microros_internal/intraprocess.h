@@ -0,0 +1,44 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_MICROROS_INTERNAL__INTRAPROCESS_H_
+#define RMW_MICROROS_INTERNAL__INTRAPROCESS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <rmw_microxrcedds_c/config.h>
+
+#ifdef RMW_UXRCE_INTRAPROCESS
+
+#include <rmw_microros/continous_serialization.h>
+
+#include "./rmw_microros_internal/types.h"
+
+/**
+ * @brief   Serializes a message into an input buffer of each local subscription matching
+ *          the publisher and pushes it to their queues, waking up any blocked rmw_wait.
+ * returns  false if the sample could not be delivered to some matching subscription.
+ */
+bool rmw_uxrce_intraprocess_publish(
+  rmw_uxrce_publisher_t * publisher,
+  const void * ros_message,
+  const rmw_uros_segment_t * segments,
+  size_t segment_count,
+  size_t topic_length);
+
+#endif  // RMW_UXRCE_INTRAPROCESS
+
+#endif  // RMW_MICROROS_INTERNAL__INTRAPROCESS_H_
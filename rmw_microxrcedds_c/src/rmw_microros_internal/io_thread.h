@@ -0,0 +1,127 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_MICROROS_INTERNAL__IO_THREAD_H_
+#define RMW_MICROROS_INTERNAL__IO_THREAD_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <uxr/client/client.h>
+#include <rmw_microxrcedds_c/config.h>
+
+#ifdef RMW_UXRCE_IO_THREAD
+
+#ifndef UCLIENT_PROFILE_MULTITHREAD
+#error RMW_UXRCE_IO_THREAD requires a Micro XRCE-DDS Client built with UCLIENT_PROFILE_MULTITHREAD
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+
+#ifndef UCLIENT_PLATFORM_POSIX
+#error RMW_UXRCE_IO_THREAD is only available on POSIX platforms
+#endif  // UCLIENT_PLATFORM_POSIX
+
+#if !defined(RMW_UXRCE_TRANSPORT_UDP) && \
+  !defined(RMW_UXRCE_TRANSPORT_TCP) && \
+  !defined(RMW_UXRCE_TRANSPORT_SERIAL)
+#error RMW_UXRCE_IO_THREAD requires a UDP, TCP or serial transport to block on
+#endif  // if !defined(RMW_UXRCE_TRANSPORT_UDP) && ...
+
+#include "./rmw_microros_internal/types.h"
+
+// Maximum time that an I/O thread blocks on its transport before serving the session,
+// so that reliable streams keep being served. The session is not held while blocked.
+#define RMW_UXRCE_IO_THREAD_PERIOD 100
+
+/**
+ * @brief   Starts the thread that spins a session and notifies incoming data.
+ * returns  true when the thread is running.
+ */
+bool rmw_uxrce_io_thread_start(
+  rmw_context_impl_t * context);
+
+/**
+ * @brief   Stops and joins the I/O thread of a session. Does nothing if it is not running.
+ */
+void rmw_uxrce_io_thread_stop(
+  rmw_context_impl_t * context);
+
+/**
+ * @brief   Initializes the readiness notification of a wait set.
+ *          It must be called with the wait_set_memory mutex held.
+ */
+void rmw_uxrce_io_thread_init_wait_set(
+  rmw_uxrce_wait_set_t * wait_set);
+
+/**
+ * @brief   Releases the readiness notification of a wait set.
+ *          It must be called with the wait_set_memory mutex held.
+ */
+void rmw_uxrce_io_thread_fini_wait_set(
+  rmw_uxrce_wait_set_t * wait_set);
+
+/**
+ * @brief   Wakes up the rmw_wait calls blocked on the wait sets that cover a session.
+ */
+void rmw_uxrce_io_thread_notify(
+  rmw_context_impl_t * context);
+
+/**
+ * @brief   Wakes up every rmw_wait blocked on readiness.
+ */
+void rmw_uxrce_io_thread_notify_all(void);
+
+/**
+ * @brief   Returns the readiness sequence of a wait set, incremented on each notification.
+ */
+uint32_t rmw_uxrce_io_thread_sequence(
+  rmw_uxrce_wait_set_t * wait_set);
+
+/**
+ * @brief   Returns a monotonic time in nanoseconds to build wait deadlines.
+ */
+int64_t rmw_uxrce_io_thread_now(void);
+
+/**
+ * @brief   Blocks until the readiness sequence of a wait set differs from `sequence` or the
+ *          monotonic `deadline` in nanoseconds is reached. A negative deadline waits forever.
+ * returns  false if the deadline was reached.
+ */
+bool rmw_uxrce_io_thread_wait(
+  rmw_uxrce_wait_set_t * wait_set,
+  uint32_t sequence,
+  int64_t deadline);
+
+/**
+ * @brief   Keeps a status reply in the mailbox of a session. When it is full of unclaimed
+ *          replies the oldest one is dropped and counted in `io_status_dropped`.
+ *          It must be called while the session is held, as from the status callback.
+ */
+void rmw_uxrce_io_thread_push_status(
+  rmw_context_impl_t * context,
+  uint16_t request,
+  uint8_t status);
+
+/**
+ * @brief   Takes the status reply of a request from the mailbox of a session.
+ *          It must be called while the session is held.
+ * returns  true if the reply had already been received.
+ */
+bool rmw_uxrce_io_thread_take_status(
+  rmw_context_impl_t * context,
+  uint16_t request,
+  uint8_t * status);
+
+#endif  // RMW_UXRCE_IO_THREAD
+
+#endif  // RMW_MICROROS_INTERNAL__IO_THREAD_H_
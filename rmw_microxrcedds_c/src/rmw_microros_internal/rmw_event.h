@@ -0,0 +1,50 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_MICROROS_INTERNAL__RMW_EVENT_H_
+#define RMW_MICROROS_INTERNAL__RMW_EVENT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <rmw/event.h>
+
+#include "./rmw_microros_internal/types.h"
+
+void rmw_uxrce_init_event_status(
+  rmw_uxrce_event_status_t * status);
+
+// Reception path hooks, called by the on_topic callback. Received samples account the
+// deadline periods missed before them and restart the deadline.
+void rmw_uxrce_subscription_message_lost(
+  rmw_uxrce_subscription_t * subscription);
+void rmw_uxrce_subscription_sample_received(
+  rmw_uxrce_subscription_t * subscription);
+
+// Publish path hook, called on each successful publication. It accounts the deadline
+// periods missed before it and restarts the deadline.
+void rmw_uxrce_publisher_sample_published(
+  rmw_uxrce_publisher_t * publisher);
+
+/**
+ * @brief   Checks if an event has unread changes, updating its deadline status.
+ * @param   next_expiration if not NULL, set to the time in nanoseconds until the next
+ *          deadline expiration, or -1 if the event has no deadline.
+ * returns  true if the event can be taken.
+ */
+bool rmw_uxrce_event_is_ready(
+  const rmw_event_t * event,
+  int64_t * next_expiration);
+
+#endif  // RMW_MICROROS_INTERNAL__RMW_EVENT_H_
@@ -25,6 +25,7 @@ extern "C"
 {
 #endif  // if defined(__cplusplus)
 
+// topic_name must outlive the topic, it is kept to recreate it
 rmw_uxrce_topic_t *
 create_topic(
   struct rmw_uxrce_node_t * custom_node,
@@ -32,6 +33,9 @@ create_topic(
   const message_type_support_callbacks_t * message_type_support_callbacks,
   const rmw_qos_profile_t * qos_policies);
 
+uint16_t buffer_topic_creation(
+  rmw_uxrce_topic_t * custom_topic);
+
 rmw_ret_t destroy_topic(
   rmw_uxrce_topic_t * topic);
 size_t topic_count(
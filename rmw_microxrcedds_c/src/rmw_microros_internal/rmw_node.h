@@ -26,4 +26,7 @@ rmw_node_t * create_node(
   size_t domain_id,
   const rmw_context_t * context);
 
+uint16_t buffer_participant_creation(
+  rmw_uxrce_node_t * custom_node);
+
 #endif  // RMW_MICROROS_INTERNAL__RMW_NODE_H_
@@ -18,10 +18,23 @@
 #include <rmw/types.h>
 #include <rosidl_runtime_c/message_type_support_struct.h>
 
+#include "./rmw_microros_internal/types.h"
+
 rmw_publisher_t * create_publisher(
   const rmw_node_t * node,
   const rosidl_message_type_support_t * type_support,
   const char * topic_name,
   const rmw_qos_profile_t * qos_policies);
 
+uint16_t buffer_publisher_creation(
+  rmw_uxrce_publisher_t * custom_publisher);
+
+uint16_t buffer_datawriter_creation(
+  rmw_uxrce_publisher_t * custom_publisher);
+
+/**
+ * @brief   Sends the samples kept by publisher allocations while their output stream was full.
+ */
+void rmw_uxrce_flush_publisher_allocations(void);
+
 #endif  // RMW_MICROROS_INTERNAL__RMW_PUBLISHER_H_
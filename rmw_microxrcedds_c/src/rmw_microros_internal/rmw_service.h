@@ -0,0 +1,26 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_MICROROS_INTERNAL__RMW_SERVICE_H_
+#define RMW_MICROROS_INTERNAL__RMW_SERVICE_H_
+
+#include "./rmw_microros_internal/types.h"
+
+uint16_t buffer_replier_creation(
+  rmw_uxrce_service_t * custom_service);
+
+uint16_t buffer_service_data_request(
+  rmw_uxrce_service_t * custom_service);
+
+#endif  // RMW_MICROROS_INTERNAL__RMW_SERVICE_H_
@@ -64,4 +64,20 @@ rmw_ret_t rmw_uxrce_transport_init(
 #define CLOSE_TRANSPORT(transport)
 #endif  // defined(RMW_UXRCE_TRANSPORT_SERIAL)
 
+#if defined(UCLIENT_PLATFORM_POSIX) && !defined(RMW_UXRCE_TRANSPORT_CUSTOM)
+#include <poll.h>
+
+// Events that leave a transport file descriptor permanently readable without data
+#define RMW_UXRCE_TRANSPORT_POLL_ERROR (POLLERR | POLLHUP | POLLNVAL)
+
+/**
+ * @brief   Returns the file descriptor of a session transport, used to poll it along with
+ *          other descriptors.
+ * @param   context The RMW context holding the transport.
+ * returns  The transport file descriptor.
+ */
+int rmw_uxrce_transport_fd(
+  const rmw_context_impl_t * context);
+#endif  // if defined(UCLIENT_PLATFORM_POSIX) && !defined(RMW_UXRCE_TRANSPORT_CUSTOM)
+
 #endif  // RMW_MICROROS_INTERNAL__RMW_UXRCE_TRANSPORTS_H_
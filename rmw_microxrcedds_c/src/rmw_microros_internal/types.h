@@ -18,6 +18,7 @@
 #include <stddef.h>
 
 #include <rmw/types.h>
+#include <rmw/event_callback_type.h>
 #include <ucdr/microcdr.h>
 #include <uxr/client/client.h>
 
@@ -25,6 +26,14 @@
 #include <uxr/client/profile/transport/custom/custom_transport.h>
 #endif  // RMW_MICROROS_INTERNAL__RMW_UXRCE_TRANSPORT_CUSTOM
 
+#ifdef RMW_UXRCE_IO_THREAD
+#include <pthread.h>
+
+// Status replies kept for the calls that start waiting for them after the I/O thread
+// has already received them
+#define RMW_UXRCE_IO_THREAD_STATUS_MAILBOX 16
+#endif  // RMW_UXRCE_IO_THREAD
+
 #include <rosidl_runtime_c/message_type_support_struct.h>
 #include <rosidl_typesupport_microxrcedds_c/message_type_support.h>
 
@@ -36,6 +45,18 @@
 
 #include "./rmw_microros_internal/memory.h"
 
+// Best effort fragments only get their own stream if the XRCE-DDS Client has an output reliable
+// stream left after the priority classes, otherwise they share the stream of their class
+#if defined(RMW_UXRCE_FRAGMENT_STREAM) && \
+  UXR_CONFIG_MAX_OUTPUT_RELIABLE_STREAMS < RMW_UXRCE_PRIORITY_CLASSES + 1
+#undef RMW_UXRCE_FRAGMENT_STREAM
+#endif
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif  // if defined(__cplusplus)
+
 // RMW specific definitions
 #ifdef RMW_UXRCE_GRAPH
 typedef struct rmw_graph_info_t
@@ -56,6 +77,16 @@ typedef struct rmw_graph_info_t
 } rmw_graph_info_t;
 #endif  // RMW_MICROROS_INTERNAL__RMW_UXRCE_GRAPH
 
+// Per kind XRCE object id allocator, destroyed ids are queued to be reused
+typedef struct rmw_uxrce_id_pool_t
+{
+  uint16_t next_id;
+  uint16_t * free_ids;
+  size_t capacity;
+  size_t free_head;
+  size_t free_count;
+} rmw_uxrce_id_pool_t;
+
 struct rmw_context_impl_s
 {
   rmw_uxrce_mempool_item_t mem;
@@ -71,6 +102,26 @@ struct rmw_context_impl_s
 #endif  // if defined(RMW_UXRCE_TRANSPORT_SERIAL)
   uxrSession session;
 
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+  // Serializes the session spinning of concurrent calls to `rmw_wait()` on this session
+  uxrMutex wait_mutex;
+  bool wait_mutex_initialized;
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+
+#ifdef RMW_UXRCE_IO_THREAD
+  pthread_t io_thread;
+  bool io_thread_running;
+  // Written to stop the I/O thread, which polls index 0 along with the transport
+  int io_thread_stop_pipe[2];
+  // Status replies received by the I/O thread, protected by the session lock
+  uint16_t io_status_requests[RMW_UXRCE_IO_THREAD_STATUS_MAILBOX];
+  uint8_t io_status[RMW_UXRCE_IO_THREAD_STATUS_MAILBOX];
+  uint64_t io_status_sequence[RMW_UXRCE_IO_THREAD_STATUS_MAILBOX];
+  uint64_t io_status_next_sequence;
+  // Unclaimed replies evicted because the mailbox was full
+  size_t io_status_dropped;
+#endif  // RMW_UXRCE_IO_THREAD
+
 #ifdef RMW_UXRCE_GRAPH
   rmw_graph_info_t graph_info;
 #endif  // if RMW_UXRCE_GRAPH
@@ -81,25 +132,63 @@ struct rmw_context_impl_s
   uxrStreamId best_effort_output;
   uxrStreamId best_effort_input;
 
+#if RMW_UXRCE_PRIORITY_CLASSES > 1
+  // Reliable output streams of the lower priority classes, the first class uses reliable_output
+  uxrStreamId priority_reliable_output[RMW_UXRCE_PRIORITY_CLASSES - 1];
+#endif  // RMW_UXRCE_PRIORITY_CLASSES > 1
+
+#ifdef RMW_UXRCE_FRAGMENT_STREAM
+  // Reliable output stream only carrying the fragments of best effort samples
+  uxrStreamId fragment_output;
+#endif  // RMW_UXRCE_FRAGMENT_STREAM
+
   uxrStreamId * creation_stream;
   uxrStreamId * destroy_stream;
   int creation_timeout;
   int destroy_timeout;
+  bool session_teardown;
 
   uint8_t input_reliable_stream_buffer[RMW_UXRCE_MAX_INPUT_BUFFER_SIZE];
   uint8_t output_reliable_stream_buffer[RMW_UXRCE_MAX_OUTPUT_BUFFER_SIZE];
   uint8_t output_best_effort_stream_buffer[RMW_UXRCE_MAX_TRANSPORT_MTU];
-
-  uint16_t id_participant;
-  uint16_t id_topic;
-  uint16_t id_publisher;
-  uint16_t id_datawriter;
-  uint16_t id_subscriber;
-  uint16_t id_datareader;
-  uint16_t id_requester;
-  uint16_t id_replier;
-
-  bool need_to_be_ran;
+#if RMW_UXRCE_PRIORITY_CLASSES > 1
+  uint8_t priority_reliable_stream_buffer[RMW_UXRCE_PRIORITY_CLASSES - 1]
+  [RMW_UXRCE_MAX_OUTPUT_BUFFER_SIZE];
+#endif  // RMW_UXRCE_PRIORITY_CLASSES > 1
+#ifdef RMW_UXRCE_FRAGMENT_STREAM
+  uint8_t fragment_stream_buffer[RMW_UXRCE_MAX_OUTPUT_BUFFER_SIZE];
+#endif  // RMW_UXRCE_FRAGMENT_STREAM
+
+  // Scratch buffer for entity creation requests, kept per session so that
+  // entities can be created concurrently on different sessions
+  char entity_naming_buffer[RMW_UXRCE_ENTITY_NAMING_BUFFER_LENGTH];
+
+  rmw_uxrce_id_pool_t id_participant;
+  rmw_uxrce_id_pool_t id_topic;
+  rmw_uxrce_id_pool_t id_publisher;
+  rmw_uxrce_id_pool_t id_datawriter;
+  rmw_uxrce_id_pool_t id_subscriber;
+  rmw_uxrce_id_pool_t id_datareader;
+  rmw_uxrce_id_pool_t id_requester;
+  rmw_uxrce_id_pool_t id_replier;
+
+  uint16_t free_participant_ids[RMW_UXRCE_MAX_NODES + 1];
+  uint16_t free_topic_ids[RMW_UXRCE_MAX_TOPICS_INTERNAL + 1];
+  uint16_t free_publisher_ids[RMW_UXRCE_MAX_PUBLISHERS + 1];
+  uint16_t free_datawriter_ids[RMW_UXRCE_MAX_PUBLISHERS + 1];
+  uint16_t free_subscriber_ids[RMW_UXRCE_MAX_SUBSCRIPTIONS + 1];
+  uint16_t free_datareader_ids[RMW_UXRCE_MAX_SUBSCRIPTIONS + 1];
+  uint16_t free_requester_ids[RMW_UXRCE_MAX_CLIENTS + 1];
+  uint16_t free_replier_ids[RMW_UXRCE_MAX_SERVICES + 1];
+
+  // Warm restart state
+  rmw_uros_session_store_t * session_store;
+  uint32_t topology_hash;
+  uint16_t topology_entities;
+  bool resuming;
+  uint16_t resume_requests[RMW_UXRCE_STREAM_HISTORY_OUTPUT];
+  size_t resume_requests_count;
+  bool resume_failed;
 };
 
 typedef struct rmw_context_impl_s rmw_uxrce_session_t;
@@ -109,6 +198,7 @@ struct rmw_init_options_impl_s
   rmw_uxrce_mempool_item_t mem;
 
   struct rmw_uxrce_transport_params_t transport_params;
+  rmw_uros_session_store_t * session_store;
 };
 
 typedef struct rmw_init_options_impl_s rmw_uxrce_init_options_impl_t;
@@ -121,10 +211,40 @@ typedef struct rmw_uxrce_topic_t
 
   uxrObjectId topic_id;
   const message_type_support_callbacks_t * message_type_support_callbacks;
+  // Topic name stored by the owner entity, used to recreate the topic
+  const char * topic_name;
 
   struct rmw_uxrce_node_t * owner_node;
 } rmw_uxrce_topic_t;
 
+// FIFO of the static input buffers received for an entity, oldest first.
+// Each entity owns its queue lock, so the reception and take paths of
+// different entities do not contend.
+typedef struct rmw_uxrce_input_queue_t
+{
+  struct rmw_uxrce_static_input_buffer_t * head;
+  struct rmw_uxrce_static_input_buffer_t * tail;
+  size_t count;
+  // Buffers handed out by rmw_uxrce_input_queue_reserve and not pushed or canceled yet,
+  // they count against the depth so concurrent receptions cannot exceed it
+  size_t reserved;
+
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+  uxrMutex mutex;
+  bool mutex_initialized;
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+} rmw_uxrce_input_queue_t;
+
+// QoS event status, counted locally by the RMW
+typedef struct rmw_uxrce_event_status_t
+{
+  size_t total_count;
+  size_t total_count_change;
+
+  rmw_event_callback_t callback;
+  const void * user_data;
+} rmw_uxrce_event_status_t;
+
 typedef struct rmw_uxrce_service_t
 {
   rmw_uxrce_mempool_item_t mem;
@@ -138,6 +258,9 @@ typedef struct rmw_uxrce_service_t
   int session_timeout;
   struct rmw_uxrce_node_t * owner_node;
 
+  // Static input buffers holding requests for this service
+  rmw_uxrce_input_queue_t input_queue;
+
   rmw_service_t rmw_service;
   char service_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
 } rmw_uxrce_service_t;
@@ -155,10 +278,22 @@ typedef struct rmw_uxrce_client_t
   int session_timeout;
   struct rmw_uxrce_node_t * owner_node;
 
+  // Static input buffers holding replies for this client
+  rmw_uxrce_input_queue_t input_queue;
+
   rmw_client_t rmw_client;
   char service_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
 } rmw_uxrce_client_t;
 
+// User-provided storage for the large samples of a subscription, protected by the
+// static_buffer_memory lock
+typedef struct rmw_uxrce_user_input_buffer_t
+{
+  uint8_t * data;
+  size_t size;
+  bool in_use;
+} rmw_uxrce_user_input_buffer_t;
+
 typedef struct rmw_uxrce_subscription_t
 {
   rmw_uxrce_mempool_item_t mem;
@@ -172,10 +307,40 @@ typedef struct rmw_uxrce_subscription_t
   rmw_qos_profile_t qos;
   uxrStreamId stream_id;
 
+  // Static input buffers holding samples for this subscription
+  rmw_uxrce_input_queue_t input_queue;
+  rmw_uxrce_user_input_buffer_t user_buffer;
+
+  // QoS events, protected by the input queue lock
+  rmw_uxrce_event_status_t message_lost;
+  rmw_uxrce_event_status_t deadline_missed;
+  int64_t deadline_start;
+
   rmw_subscription_t rmw_subscription;
   char topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
 } rmw_uxrce_subscription_t;
 
+#if RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+// Samples received as fragments take at most a whole input stream
+#define RMW_UXRCE_SUBSCRIPTION_ALLOCATION_SIZE RMW_UXRCE_MAX_INPUT_BUFFER_SIZE
+
+// Subscription allocations only accept type supports deserializing into the memory
+// preallocated in the message
+typedef struct rmw_uxrce_subscription_allocation_t
+{
+  rmw_uxrce_mempool_item_t mem;
+  const message_type_support_callbacks_t * type_support_callbacks;
+
+  // Serialized sample moved out of the input queue, it is deserialized from here
+  uint8_t buffer[RMW_UXRCE_SUBSCRIPTION_ALLOCATION_SIZE];
+
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+  uxrMutex mutex;
+  bool mutex_initialized;
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+} rmw_uxrce_subscription_allocation_t;
+#endif  // RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+
 typedef struct rmw_uxrce_publisher_t
 {
   rmw_uxrce_mempool_item_t mem;
@@ -192,19 +357,60 @@ typedef struct rmw_uxrce_publisher_t
   rmw_qos_profile_t qos;
   uxrStreamId stream_id;
   int session_timeout;
+  // Lower values are served first, 0 is the highest priority
+  uint8_t priority_class;
 
   struct rmw_uxrce_node_t * owner_node;
 
+  // QoS events, written when publishing and read by rmw_wait
+  rmw_uxrce_event_status_t deadline_missed;
+  int64_t deadline_start;
+
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+  // Protects the QoS events and the stream of the priority class. Publisher slots are reused,
+  // so it is only created once
+  uxrMutex mutex;
+  bool mutex_initialized;
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+
+#ifdef RMW_UXRCE_INTRAPROCESS
+  // Samples are only delivered to subscriptions of this context
+  bool local_only;
+#endif  // RMW_UXRCE_INTRAPROCESS
+
   rmw_publisher_t rmw_publisher;
   char topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
 } rmw_uxrce_publisher_t;
 
+#if RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+// Samples bigger than a MTU are written as fragments, at most a whole output stream at once
+#define RMW_UXRCE_PUBLISHER_ALLOCATION_SIZE RMW_UXRCE_MAX_OUTPUT_BUFFER_SIZE
+
+typedef struct rmw_uxrce_publisher_allocation_t
+{
+  rmw_uxrce_mempool_item_t mem;
+  const message_type_support_callbacks_t * type_support_callbacks;
+
+  // Serialized sample waiting for room in the output stream of its publisher
+  struct rmw_uxrce_publisher_t * publisher;
+  bool pending;
+  size_t length;
+  uint8_t buffer[RMW_UXRCE_PUBLISHER_ALLOCATION_SIZE];
+
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+  uxrMutex mutex;
+  bool mutex_initialized;
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+} rmw_uxrce_publisher_allocation_t;
+#endif  // RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+
 typedef struct rmw_uxrce_node_t
 {
   rmw_uxrce_mempool_item_t mem;
   rmw_uxrce_session_t * context;
 
   uxrObjectId participant_id;
+  size_t domain_id;
 
   rmw_node_t rmw_node;
   char node_name[RMW_UXRCE_NODE_NAME_MAX_LENGTH];
@@ -224,16 +430,31 @@ typedef enum rmw_uxrce_entity_type_t
   RMW_UXRCE_ENTITY_TYPE_PUBLISHER
 } rmw_uxrce_entity_type_t;
 
-typedef struct rmw_uxrce_static_input_buffer_t
+#if RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+// Storage for samples that do not fit in a history slot
+typedef struct rmw_uxrce_large_input_buffer_t
 {
   rmw_uxrce_mempool_item_t mem;
 
   uint8_t buffer[RMW_UXRCE_MAX_INPUT_BUFFER_SIZE];
+} rmw_uxrce_large_input_buffer_t;
+#endif  // RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+
+typedef struct rmw_uxrce_static_input_buffer_t
+{
+  rmw_uxrce_mempool_item_t mem;
+
+  uint8_t data[RMW_UXRCE_STATIC_INPUT_BUFFER_SIZE];
+  // Points to data or to the large storage holding this sample
+  uint8_t * buffer;
   size_t length;
-  void * owner;
+  struct rmw_uxrce_static_input_buffer_t * queue_next;
+
+  // Large storage attached to this slot, if any
+  struct rmw_uxrce_large_input_buffer_t * large_buffer;
+  struct rmw_uxrce_user_input_buffer_t * user_buffer;
 
   int64_t timestamp;
-  rmw_uxrce_entity_type_t entity_type;
 
   union {
     int64_t reply_id;
@@ -245,6 +466,24 @@ typedef struct rmw_uxrce_wait_set_t
 {
   rmw_uxrce_mempool_item_t mem;
 
+  // Sessions that own the entities attached in the last rmw_wait call,
+  // protected by the wait_set_memory mutex
+  bool sessions_valid;
+  rmw_uxrce_session_t * sessions[RMW_UXRCE_MAX_SESSIONS];
+  bool session_cached[RMW_UXRCE_MAX_SESSIONS];
+  size_t session_count;
+
+  // Self-pipe that interrupts a blocking rmw_wait when a guard condition is triggered:
+  // index 0 is polled and index 1 is written on each signal
+  int wakeup_pipe[2];
+
+#ifdef RMW_UXRCE_IO_THREAD
+  // Readiness notifications of the I/O threads of the cached sessions
+  pthread_mutex_t io_mutex;
+  pthread_cond_t io_cond;
+  uint32_t io_sequence;
+#endif  // RMW_UXRCE_IO_THREAD
+
   rmw_wait_set_t rmw_wait_set;
 } rmw_uxrce_wait_set_t;
 
@@ -259,8 +498,6 @@ typedef struct rmw_uxrce_guard_condition_t
 
 // Static memory pools
 
-extern char rmw_uxrce_entity_naming_buffer[RMW_UXRCE_ENTITY_NAMING_BUFFER_LENGTH];
-
 extern rmw_uxrce_mempool_t session_memory;
 extern rmw_uxrce_session_t custom_sessions[RMW_UXRCE_MAX_SESSIONS];
 
@@ -273,6 +510,12 @@ extern rmw_uxrce_publisher_t custom_publishers[RMW_UXRCE_MAX_PUBLISHERS];
 extern rmw_uxrce_mempool_t subscription_memory;
 extern rmw_uxrce_subscription_t custom_subscriptions[RMW_UXRCE_MAX_SUBSCRIPTIONS];
 
+#if RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+extern rmw_uxrce_mempool_t subscription_allocation_memory;
+extern rmw_uxrce_subscription_allocation_t
+  custom_subscription_allocations[RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS];
+#endif  // RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+
 extern rmw_uxrce_mempool_t service_memory;
 extern rmw_uxrce_service_t custom_services[RMW_UXRCE_MAX_SERVICES];
 
@@ -285,6 +528,17 @@ extern rmw_uxrce_topic_t custom_topics[RMW_UXRCE_MAX_TOPICS_INTERNAL];
 extern rmw_uxrce_mempool_t static_buffer_memory;
 extern rmw_uxrce_static_input_buffer_t custom_static_buffers[RMW_UXRCE_MAX_HISTORY];
 
+#if RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+extern rmw_uxrce_mempool_t large_input_buffer_memory;
+extern rmw_uxrce_large_input_buffer_t custom_large_input_buffers[RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS];
+#endif  // RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+
+#if RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+extern rmw_uxrce_mempool_t publisher_allocation_memory;
+extern rmw_uxrce_publisher_allocation_t
+  custom_publisher_allocations[RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS];
+#endif  // RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+
 extern rmw_uxrce_mempool_t init_options_memory;
 extern rmw_uxrce_init_options_impl_t custom_init_options[RMW_UXRCE_MAX_OPTIONS];
 
@@ -296,10 +550,12 @@ extern rmw_uxrce_guard_condition_t custom_guard_condition[RMW_UXRCE_MAX_GUARD_CO
 
 // Global mutexs
 #ifdef UCLIENT_PROFILE_MULTITHREAD
-// This mutex protects `need_to_be_ran` member of `session_memory` elements
-// between concurrent calls to `rmw_wait()`
-extern uxrMutex rmw_uxrce_wait_mutex;
-extern bool rmw_uxrce_wait_mutex_initialized;
+// This mutex protects the type name cache shared by all sessions
+extern uxrMutex rmw_uxrce_name_cache_mutex;
+extern bool rmw_uxrce_name_cache_mutex_initialized;
+// This mutex protects the custom transport wakeup callback, it is set from any thread
+extern uxrMutex rmw_uxrce_wakeup_callback_mutex;
+extern bool rmw_uxrce_wakeup_callback_mutex_initialized;
 #endif  // UCLIENT_PROFILE_MULTITHREAD
 
 // Memory init functions
@@ -314,10 +570,19 @@ RMW_INIT_DEFINE_MEMORY(service)
 RMW_INIT_DEFINE_MEMORY(client)
 RMW_INIT_DEFINE_MEMORY(publisher)
 RMW_INIT_DEFINE_MEMORY(subscription)
+#if RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+RMW_INIT_DEFINE_MEMORY(subscription_allocation)
+#endif  // RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
 RMW_INIT_DEFINE_MEMORY(node)
 RMW_INIT_DEFINE_MEMORY(session)
 RMW_INIT_DEFINE_MEMORY(topic)
 RMW_INIT_DEFINE_MEMORY(static_input_buffer)
+#if RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+RMW_INIT_DEFINE_MEMORY(large_input_buffer)
+#endif  // RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+#if RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+RMW_INIT_DEFINE_MEMORY(publisher_allocation)
+#endif  // RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
 RMW_INIT_DEFINE_MEMORY(init_options_impl)
 RMW_INIT_DEFINE_MEMORY(wait_set)
 RMW_INIT_DEFINE_MEMORY(guard_condition)
@@ -339,13 +604,43 @@ void rmw_uxrce_fini_service_memory(
 void rmw_uxrce_fini_topic_memory(
   rmw_uxrce_topic_t * topic);
 
+// Drops the sessions cached by every wait set
+void rmw_uxrce_invalidate_wait_sets(void);
+
 // Memory pools functions
 
-rmw_uxrce_mempool_item_t * rmw_uxrce_get_static_input_buffer_for_entity(
-  void * entity,
-  const rmw_qos_profile_t qos);
-rmw_uxrce_mempool_item_t * rmw_uxrce_find_static_input_buffer_by_owner(
-  void * owner);
-void rmw_uxrce_clean_expired_static_input_buffer(void);
+void rmw_uxrce_put_static_input_buffer(
+  rmw_uxrce_static_input_buffer_t * static_buffer);
+bool rmw_uxrce_static_input_buffer_fit(
+  rmw_uxrce_static_input_buffer_t * static_buffer,
+  rmw_uxrce_user_input_buffer_t * user_buffer,
+  size_t length);
+
+// Entity input queue functions
+
+void rmw_uxrce_init_input_queue(
+  rmw_uxrce_input_queue_t * queue);
+rmw_uxrce_static_input_buffer_t * rmw_uxrce_input_queue_reserve(
+  rmw_uxrce_input_queue_t * queue,
+  const rmw_qos_profile_t * qos,
+  bool * sample_lost);
+void rmw_uxrce_input_queue_push(
+  rmw_uxrce_input_queue_t * queue,
+  rmw_uxrce_static_input_buffer_t * static_buffer);
+void rmw_uxrce_input_queue_cancel(
+  rmw_uxrce_input_queue_t * queue,
+  rmw_uxrce_static_input_buffer_t * static_buffer);
+rmw_uxrce_static_input_buffer_t * rmw_uxrce_input_queue_pop(
+  rmw_uxrce_input_queue_t * queue,
+  const rmw_qos_profile_t * qos);
+void rmw_uxrce_input_queue_clean_expired(
+  rmw_uxrce_input_queue_t * queue,
+  const rmw_qos_profile_t * qos);
+void rmw_uxrce_input_queue_clear(
+  rmw_uxrce_input_queue_t * queue);
+
+#if defined(__cplusplus)
+}
+#endif  // if defined(__cplusplus)
 
 #endif  // RMW_MICROROS_INTERNAL__TYPES_H_
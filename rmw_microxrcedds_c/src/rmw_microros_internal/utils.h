@@ -19,12 +19,58 @@
 
 #include "./rmw_microros_internal/types.h"
 
+#define RMW_UXRCE_TOPOLOGY_HASH_SEED 2166136261u
+// Deletion requests are small, a whole batch fits in a single MTU
+#define RMW_UXRCE_MAX_DELETION_BATCH 16
+#define RMW_UXRCE_MAX_OBJECT_ID 0x0FFF
+
 bool run_xrce_session(
   rmw_context_impl_t * context,
   uxrStreamId * target_stream,
   uint16_t requests,
   int timeout);
 
+bool run_xrce_session_until_all_status(
+  rmw_context_impl_t * context,
+  int timeout,
+  const uint16_t * requests,
+  uint8_t * status,
+  size_t count);
+
+uxrStreamId get_priority_reliable_output(
+  rmw_context_impl_t * context,
+  uint8_t priority_class);
+
+bool run_xrce_creation(
+  rmw_context_impl_t * context,
+  const uxrObjectId * object_id,
+  const char * name,
+  uint16_t request);
+
+bool flush_xrce_creation(
+  rmw_context_impl_t * context);
+
+bool run_xrce_deletion(
+  rmw_context_impl_t * context,
+  bool cancel_data,
+  const uxrObjectId * object_ids,
+  size_t count);
+
+bool run_xrce_context_deletion(
+  rmw_context_impl_t * context);
+
+void init_xrce_object_ids(
+  rmw_context_impl_t * context);
+
+bool acquire_xrce_object_id(
+  rmw_context_impl_t * context,
+  uint8_t type,
+  uxrObjectId * object_id);
+
+void release_xrce_object_id(
+  rmw_context_impl_t * context,
+  const uxrObjectId * object_id);
+
 uxrQoS_t convert_qos_profile(const rmw_qos_profile_t * rmw_qos);
 
 int generate_name(
@@ -0,0 +1,83 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_MICROROS_INTERNAL__WAKEUP_H_
+#define RMW_MICROROS_INTERNAL__WAKEUP_H_
+
+#include <stdbool.h>
+
+#include <uxr/client/client.h>
+#include <rmw_microxrcedds_c/config.h>
+
+#include "./rmw_microros_internal/types.h"
+
+#if defined(UCLIENT_PLATFORM_POSIX) && \
+  (defined(RMW_UXRCE_TRANSPORT_UDP) || \
+  defined(RMW_UXRCE_TRANSPORT_TCP) || \
+  defined(RMW_UXRCE_TRANSPORT_SERIAL))
+// rmw_wait polls the transport file descriptors along with the wait set wakeup pipe
+#define RMW_UXRCE_WAIT_POLL
+#endif  // if defined(UCLIENT_PLATFORM_POSIX) && ...
+
+// Maximum time that rmw_wait blocks in a poll call before spinning the sessions,
+// so that reliable streams keep being served during long waits. Without poll it bounds
+// each session read, guard conditions are checked in between.
+#define RMW_UXRCE_WAIT_POLL_PERIOD 100
+
+typedef void (* rmw_uxrce_wakeup_callback_t)(void * args);
+
+/**
+ * @brief   Creates the wakeup channel used to interrupt a blocking rmw_wait on a wait set.
+ *          The wait set pipe must be initialized to -1, it is kept so when it cannot be created.
+ * returns  true when the channel is available.
+ */
+bool rmw_uxrce_wakeup_init(
+  rmw_uxrce_wait_set_t * wait_set);
+
+/**
+ * @brief   Releases the wakeup channel of a wait set.
+ */
+void rmw_uxrce_wakeup_fini(
+  rmw_uxrce_wait_set_t * wait_set);
+
+/**
+ * @brief   Interrupts any rmw_wait blocked on a session transport. Each wait set
+ *          is woken up and keeps waiting if none of its guard conditions has triggered.
+ */
+void rmw_uxrce_wakeup_signal(void);
+
+/**
+ * @brief   Sets a user callback called on each wakeup signal. Used by custom
+ *          transports to interrupt a blocking read.
+ */
+void rmw_uxrce_wakeup_set_callback(
+  rmw_uxrce_wakeup_callback_t callback,
+  void * args);
+
+#ifdef RMW_UXRCE_WAIT_POLL
+/**
+ * @brief   Returns the file descriptor of a wait set that becomes readable on a wakeup signal,
+ *          or -1 if the channel is not available.
+ */
+int rmw_uxrce_wakeup_fd(
+  rmw_uxrce_wait_set_t * wait_set);
+
+/**
+ * @brief   Consumes all the pending wakeup signals of a wait set.
+ */
+void rmw_uxrce_wakeup_drain(
+  rmw_uxrce_wait_set_t * wait_set);
+#endif  // RMW_UXRCE_WAIT_POLL
+
+#endif  // RMW_MICROROS_INTERNAL__WAKEUP_H_
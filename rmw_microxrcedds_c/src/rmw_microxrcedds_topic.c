@@ -21,6 +21,55 @@
 #include "./rmw_microros_internal/utils.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
+uint16_t buffer_topic_creation(
+  rmw_uxrce_topic_t * custom_topic)
+{
+  rmw_uxrce_node_t * custom_node = custom_topic->owner_node;
+  uint16_t topic_req = UXR_INVALID_REQUEST_ID;
+
+#ifdef RMW_UXRCE_USE_REFS
+  if (!build_topic_profile(
+      custom_topic->topic_name, custom_node->context->entity_naming_buffer,
+      sizeof(custom_node->context->entity_naming_buffer)))
+  {
+    RMW_UROS_TRACE_MESSAGE("failed to generate xml request for node creation")
+    return UXR_INVALID_REQUEST_ID;
+  }
+
+  topic_req = uxr_buffer_create_topic_ref(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream, custom_topic->topic_id,
+    custom_node->participant_id, custom_node->context->entity_naming_buffer,
+    UXR_REPLACE | UXR_REUSE);
+#else
+  char full_topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
+  char type_name[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
+
+  if (!generate_topic_name(custom_topic->topic_name, full_topic_name, sizeof(full_topic_name))) {
+    RMW_UROS_TRACE_MESSAGE("Error creating topic name");
+    return UXR_INVALID_REQUEST_ID;
+  }
+
+  if (!generate_type_name(
+      custom_topic->message_type_support_callbacks, type_name, sizeof(type_name)))
+  {
+    RMW_UROS_TRACE_MESSAGE("Error creating type name");
+    return UXR_INVALID_REQUEST_ID;
+  }
+
+  topic_req = uxr_buffer_create_topic_bin(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream,
+    custom_topic->topic_id,
+    custom_node->participant_id,
+    full_topic_name,
+    type_name,
+    UXR_REPLACE | UXR_REUSE);
+#endif /* ifdef RMW_UXRCE_USE_XML */
+
+  return topic_req;
+}
+
 rmw_uxrce_topic_t *
 create_topic(
   struct rmw_uxrce_node_t * custom_node,
@@ -42,56 +91,22 @@ create_topic(
 
   // Init
   custom_topic->owner_node = custom_node;
+  custom_topic->topic_name = topic_name;
+  custom_topic->topic_id = uxr_object_id(0, UXR_INVALID_ID);
 
   // Asociate to typesupport
   custom_topic->message_type_support_callbacks = message_type_support_callbacks;
 
   // Generate topic id
-  custom_topic->topic_id = uxr_object_id(custom_node->context->id_topic++, UXR_TOPIC_ID);
-
-  // Generate request
-  uint16_t topic_req = 0;
-#ifdef RMW_UXRCE_USE_REFS
-  (void)qos_policies;
-  if (!build_topic_profile(
-      topic_name, rmw_uxrce_entity_naming_buffer,
-      sizeof(rmw_uxrce_entity_naming_buffer)))
-  {
-    RMW_UROS_TRACE_MESSAGE("failed to generate xml request for node creation")
-    goto fail;
-  }
-
-  topic_req = uxr_buffer_create_topic_ref(
-    &custom_node->context->session,
-    *custom_node->context->creation_stream, custom_topic->topic_id,
-    custom_node->participant_id, rmw_uxrce_entity_naming_buffer, UXR_REPLACE | UXR_REUSE);
-#else
-  static char full_topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
-  static char type_name[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
-
-  if (!generate_topic_name(topic_name, full_topic_name, sizeof(full_topic_name))) {
-    RMW_UROS_TRACE_MESSAGE("Error creating topic name");
+  if (!acquire_xrce_object_id(custom_node->context, UXR_TOPIC_ID, &custom_topic->topic_id)) {
     goto fail;
   }
 
-  if (!generate_type_name(message_type_support_callbacks, type_name, sizeof(type_name))) {
-    RMW_UROS_TRACE_MESSAGE("Error creating type name");
-    goto fail;
-  }
-
-  topic_req = uxr_buffer_create_topic_bin(
-    &custom_node->context->session,
-    *custom_node->context->creation_stream,
-    custom_topic->topic_id,
-    custom_node->participant_id,
-    full_topic_name,
-    type_name,
-    UXR_REPLACE | UXR_REUSE);
-#endif /* ifdef RMW_UXRCE_USE_XML */
+  // Generate request
+  uint16_t topic_req = buffer_topic_creation(custom_topic);
 
-  if (!run_xrce_session(
-      custom_node->context, custom_node->context->creation_stream, topic_req,
-      custom_node->context->creation_timeout))
+  if (!run_xrce_creation(
+      custom_node->context, &custom_topic->topic_id, topic_name, topic_req))
   {
     goto fail;
   }
@@ -100,6 +115,7 @@ create_topic(
 
 fail:
   if (custom_topic != NULL) {
+    release_xrce_object_id(custom_node->context, &custom_topic->topic_id);
     rmw_uxrce_fini_topic_memory(custom_topic);
   }
 
@@ -114,14 +130,8 @@ rmw_ret_t destroy_topic(
   if (topic->owner_node != NULL) {
     rmw_uxrce_node_t * custom_node = topic->owner_node;
 
-    uint16_t delete_topic = uxr_buffer_delete_entity(
-      &custom_node->context->session,
-      *custom_node->context->destroy_stream,
-      topic->topic_id);
-
-    if (!run_xrce_session(
-        custom_node->context, custom_node->context->destroy_stream, delete_topic,
-        custom_node->context->destroy_timeout))
+    if (!run_xrce_deletion(
+        custom_node->context, false, &topic->topic_id, 1))
     {
       result_ret = RMW_RET_TIMEOUT;
     }
@@ -24,6 +24,48 @@
 #include "./rmw_microros_internal/identifiers.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
+uint16_t buffer_participant_creation(
+  rmw_uxrce_node_t * custom_node)
+{
+  uint16_t participant_req = UXR_INVALID_REQUEST_ID;
+
+#ifdef RMW_UXRCE_USE_REFS
+  if (!build_participant_profile(
+      custom_node->context->entity_naming_buffer,
+      sizeof(custom_node->context->entity_naming_buffer)))
+  {
+    RMW_UROS_TRACE_MESSAGE("failed to generate xml request for node creation")
+    return UXR_INVALID_REQUEST_ID;
+  }
+  participant_req = uxr_buffer_create_participant_ref(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream,
+    custom_node->participant_id,
+    (uint16_t)custom_node->domain_id,
+    custom_node->context->entity_naming_buffer, UXR_REPLACE | UXR_REUSE);
+#else
+  char xrce_node_name[RMW_UXRCE_NODE_NAME_MAX_LENGTH];
+
+  if (strcmp(custom_node->node_namespace, "/") == 0) {
+    snprintf(xrce_node_name, RMW_UXRCE_NODE_NAME_MAX_LENGTH, "%s", custom_node->node_name);
+  } else {
+    snprintf(
+      xrce_node_name, RMW_UXRCE_NODE_NAME_MAX_LENGTH, "%s/%s",
+      custom_node->node_namespace, custom_node->node_name);
+  }
+
+  participant_req = uxr_buffer_create_participant_bin(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream,
+    custom_node->participant_id,
+    custom_node->domain_id,
+    xrce_node_name,
+    UXR_REPLACE | UXR_REUSE);
+#endif /* ifdef RMW_UXRCE_USE_REFS */
+
+  return participant_req;
+}
+
 rmw_node_t * create_node(
   const char * name,
   const char * namespace_,
@@ -46,6 +88,8 @@ rmw_node_t * create_node(
   rmw_uxrce_node_t * custom_node = (rmw_uxrce_node_t *)memory_node->data;
 
   custom_node->context = context->impl;
+  custom_node->domain_id = domain_id;
+  custom_node->participant_id = uxr_object_id(0, UXR_INVALID_ID);
 
   node_handle = &custom_node->rmw_node;
 
@@ -69,46 +113,17 @@ rmw_node_t * create_node(
 
   memcpy((char *)node_handle->namespace_, namespace_, strlen(namespace_) + 1);
 
-  custom_node->participant_id =
-    uxr_object_id(custom_node->context->id_participant++, UXR_PARTICIPANT_ID);
-  uint16_t participant_req = UXR_INVALID_REQUEST_ID;
-
-#ifdef RMW_UXRCE_USE_REFS
-  if (!build_participant_profile(
-      rmw_uxrce_entity_naming_buffer,
-      sizeof(rmw_uxrce_entity_naming_buffer)))
+  if (!acquire_xrce_object_id(
+      custom_node->context, UXR_PARTICIPANT_ID, &custom_node->participant_id))
   {
-    RMW_UROS_TRACE_MESSAGE("failed to generate xml request for node creation")
-    return NULL;
-  }
-  participant_req = uxr_buffer_create_participant_ref(
-    &custom_node->context->session,
-    *custom_node->context->creation_stream,
-    custom_node->participant_id,
-    (uint16_t)domain_id,
-    rmw_uxrce_entity_naming_buffer, UXR_REPLACE | UXR_REUSE);
-#else
-  static char xrce_node_name[RMW_UXRCE_NODE_NAME_MAX_LENGTH];
-
-  if (strcmp(namespace_, "/") == 0) {
-    snprintf(xrce_node_name, RMW_UXRCE_NODE_NAME_MAX_LENGTH, "%s", name);
-  } else {
-    snprintf(xrce_node_name, RMW_UXRCE_NODE_NAME_MAX_LENGTH, "%s/%s", namespace_, name);
+    goto fail;
   }
+  uint16_t participant_req = buffer_participant_creation(custom_node);
 
-  participant_req = uxr_buffer_create_participant_bin(
-    &custom_node->context->session,
-    *custom_node->context->creation_stream,
-    custom_node->participant_id,
-    domain_id,
-    xrce_node_name,
-    UXR_REPLACE | UXR_REUSE);
-#endif /* ifdef RMW_UXRCE_USE_REFS */
-
-  if (!run_xrce_session(
-      custom_node->context, custom_node->context->creation_stream, participant_req,
-      custom_node->context->creation_timeout))
+  if (!run_xrce_creation(
+      custom_node->context, &custom_node->participant_id, name, participant_req))
   {
+    release_xrce_object_id(custom_node->context, &custom_node->participant_id);
     rmw_uxrce_fini_node_memory(node_handle);
     return NULL;
   }
@@ -216,14 +231,8 @@ rmw_ret_t rmw_destroy_node(
     }
   }
 
-  uint16_t delete_participant = uxr_buffer_delete_entity(
-    &custom_node->context->session,
-    *custom_node->context->destroy_stream,
-    custom_node->participant_id);
-
-  if (!run_xrce_session(
-      custom_node->context, custom_node->context->destroy_stream, delete_participant,
-      custom_node->context->destroy_timeout))
+  if (!run_xrce_deletion(
+      custom_node->context, false, &custom_node->participant_id, 1))
   {
     ret = RMW_RET_TIMEOUT;
   }
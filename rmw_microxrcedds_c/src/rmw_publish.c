@@ -15,17 +15,403 @@
 #include <rmw/rmw.h>
 #include <rmw_microros/rmw_microros.h>
 #include <uxr/client/profile/multithread/multithread.h>
+#include <uxr/client/core/session/stream/seq_num.h>
+#include <uxr/client/util/time.h>
+
+#include <string.h>
 
 #include "./rmw_microros_internal/types.h"
 #include "./rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/rmw_event.h"
+#include "./rmw_microros_internal/intraprocess.h"
+#include "./rmw_microros_internal/rmw_publisher.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
+// Only waits for the acknowledgements of the given reliable stream, so a publisher is never
+// blocked behind the samples pending in the streams of other priority classes
+static bool run_session_until_stream_confirmed(
+  uxrSession * session,
+  uxrStreamId stream_id,
+  int timeout)
+{
+  const uxrOutputReliableStream * stream = &session->streams.output_reliable[stream_id.index];
+  int64_t start = uxr_millis();
+  int remaining = timeout;
+
+  uxr_flash_output_streams(session);
+
+  bool confirmed = 0 == uxr_seq_num_cmp(stream->last_acknown, stream->last_sent);
+  while (!confirmed && (0 > timeout || 0 < remaining)) {
+    uxr_run_session_until_timeout(session, (0 > timeout) ? UXR_TIMEOUT_INF : remaining);
+    confirmed = 0 == uxr_seq_num_cmp(stream->last_acknown, stream->last_sent);
+    remaining = timeout - (int)(uxr_millis() - start);
+  }
+
+  return confirmed;
+}
+
 bool flush_session(
   uxrSession * session,
   void * args)
 {
   rmw_uxrce_publisher_t * custom_publisher = (rmw_uxrce_publisher_t *)args;
-  return uxr_run_session_until_confirm_delivery(session, custom_publisher->session_timeout);
+  return run_session_until_stream_confirmed(
+    session, custom_publisher->stream_id, custom_publisher->session_timeout);
+}
+
+// Bytes of each fragment taken by its subheader, and by the WRITE_DATA header of the first one.
+// The XRCE-DDS Client keeps SUBHEADER_SIZE private, WRITE_DATA_PAYLOAD_SIZE is its base request.
+#define RMW_UXRCE_FRAGMENT_HEADER_SIZE 4
+#define RMW_UXRCE_WRITE_DATA_HEADER_SIZE \
+  (RMW_UXRCE_FRAGMENT_HEADER_SIZE + sizeof(BaseObjectRequest))
+
+// Reliable stream carrying the fragments of a best effort publisher
+static uxrStreamId rmw_uxrce_fragment_stream(
+  rmw_uxrce_publisher_t * custom_publisher)
+{
+#ifdef RMW_UXRCE_FRAGMENT_STREAM
+  return custom_publisher->owner_node->context->fragment_output;
+#else
+  return get_priority_reliable_output(
+    custom_publisher->owner_node->context, custom_publisher->priority_class);
+#endif  // RMW_UXRCE_FRAGMENT_STREAM
+}
+
+// History slots of a reliable output stream not holding unacknowledged data.
+// The last written slot counts as used even if it still has room.
+static uint16_t rmw_uxrce_stream_free_slots(
+  uxrSession * session,
+  uxrStreamId stream_id)
+{
+  const uxrOutputReliableStream * stream = &session->streams.output_reliable[stream_id.index];
+  uint16_t used = (uint16_t)uxr_seq_num_sub(stream->last_written, stream->last_acknown);
+  return (used < stream->base.history) ? (uint16_t)(stream->base.history - used) : 0;
+}
+
+static uint16_t rmw_uxrce_stream_fragment_count(
+  uxrSession * session,
+  uxrStreamId stream_id,
+  uint32_t topic_length)
+{
+  const uxrOutputReliableStream * stream = &session->streams.output_reliable[stream_id.index];
+  size_t slot_size = stream->base.size / stream->base.history;
+  size_t fragment_size = slot_size - stream->offset - RMW_UXRCE_FRAGMENT_HEADER_SIZE;
+  size_t length = (size_t)topic_length + RMW_UXRCE_WRITE_DATA_HEADER_SIZE;
+  return (uint16_t)((length + fragment_size - 1) / fragment_size);
+}
+
+static bool flush_session_nonblocking(
+  uxrSession * session,
+  void * args)
+{
+  uxrStreamId * stream_id = (uxrStreamId *)args;
+
+  // Send the fragments written so far and process the pending acknacks, never wait for them.
+  // Writing only goes on if a slot has been freed.
+  uxr_flash_output_streams(session);
+  uxr_run_session_timeout(session, 0);
+  return 0 < rmw_uxrce_stream_free_slots(session, *stream_id);
+}
+
+// Writes the sample as fragments without blocking. It is dropped unless all of them fit in
+// the free slots of the reliable stream, so that a chain is never left truncated.
+// On success the stream stays locked by the XRCE client until UXR_UNLOCK_STREAM_ID.
+static bool rmw_uxrce_prepare_fragments(
+  rmw_uxrce_publisher_t * custom_publisher,
+  uxrStreamId * stream_id,
+  ucdrBuffer * mb,
+  uint32_t topic_length)
+{
+  uxrSession * session = &custom_publisher->owner_node->context->session;
+  bool prepared = false;
+
+  UXR_LOCK(&session->mutex);
+  if (rmw_uxrce_stream_fragment_count(session, *stream_id, topic_length) <=
+    rmw_uxrce_stream_free_slots(session, *stream_id))
+  {
+    prepared = uxr_prepare_output_stream_fragmented(
+      session, *stream_id, custom_publisher->datawriter_id, mb,
+      topic_length, flush_session_nonblocking, stream_id);
+  }
+  UXR_UNLOCK(&session->mutex);
+
+  return prepared;
+}
+
+static bool rmw_uxrce_prepare_publication(
+  rmw_uxrce_publisher_t * custom_publisher,
+  ucdrBuffer * mb,
+  uint32_t topic_length,
+  uxrStreamId * stream_id)
+{
+  uxrSession * session = &custom_publisher->owner_node->context->session;
+  *stream_id = custom_publisher->stream_id;
+
+  if (uxr_prepare_output_stream(
+      session, *stream_id, custom_publisher->datawriter_id, mb, topic_length))
+  {
+    return true;
+  }
+
+  if (UXR_RELIABLE_STREAM == stream_id->type) {
+    return uxr_prepare_output_stream_fragmented(
+      session, *stream_id, custom_publisher->datawriter_id, mb,
+      topic_length, flush_session, custom_publisher);
+  }
+
+  // Best effort streams cannot carry fragments, they are sent back-to-back through a reliable
+  // stream without waiting for acknowledgements
+  *stream_id = rmw_uxrce_fragment_stream(custom_publisher);
+  return rmw_uxrce_prepare_fragments(custom_publisher, stream_id, mb, topic_length);
+}
+
+static bool rmw_uxrce_serialize_segments(
+  ucdrBuffer * mb,
+  const rmw_uros_segment_t * segments,
+  size_t segment_count)
+{
+  bool ret = true;
+  for (size_t i = 0; i < segment_count && ret; i++) {
+    ret = ucdr_serialize_array_uint8_t(mb, segments[i].data, segments[i].length);
+  }
+  return ret;
+}
+
+// A NULL ros_message publishes the segments alone, they must hold an already serialized message
+static rmw_ret_t rmw_uxrce_publish(
+  rmw_uxrce_publisher_t * custom_publisher,
+  const void * ros_message,
+  const rmw_uros_segment_t * segments,
+  size_t segment_count)
+{
+  const message_type_support_callbacks_t * functions = custom_publisher->type_support_callbacks;
+  uint32_t topic_length = 0;
+
+  if (NULL != ros_message) {
+    topic_length = functions->get_serialized_size(ros_message);
+
+    if (custom_publisher->cs_cb_size) {
+      custom_publisher->cs_cb_size(&topic_length);
+    }
+  }
+
+  for (size_t i = 0; i < segment_count; i++) {
+    topic_length += (uint32_t)segments[i].length;
+  }
+
+#ifdef RMW_UXRCE_INTRAPROCESS
+  // Local only samples go straight to the subscriptions of this context. Samples sent to
+  // the Agent reach local subscriptions through it, as they cannot be told apart from
+  // identical remote samples once they come back.
+  if (custom_publisher->local_only) {
+    if (!rmw_uxrce_intraprocess_publish(
+        custom_publisher, ros_message, segments, segment_count, topic_length))
+    {
+      RMW_UROS_TRACE_MESSAGE("error publishing message")
+      return RMW_RET_ERROR;
+    }
+
+    rmw_uxrce_publisher_sample_published(custom_publisher);
+    return RMW_RET_OK;
+  }
+#endif  // RMW_UXRCE_INTRAPROCESS
+
+  ucdrBuffer mb;
+  uxrStreamId stream_id;
+  bool written = false;
+
+  // The priority class can move the publisher to another stream, so it is held until the
+  // sample is in the stream
+  UXR_LOCK(&custom_publisher->mutex);
+
+  if (rmw_uxrce_prepare_publication(custom_publisher, &mb, topic_length, &stream_id)) {
+    written = true;
+    if (NULL != ros_message) {
+      written = functions->cdr_serialize(ros_message, &mb);
+      if (custom_publisher->cs_cb_serialization) {
+        custom_publisher->cs_cb_serialization(&mb);
+      }
+    }
+
+    // Segments are copied from the user memory straight into the stream slots
+    written &= rmw_uxrce_serialize_segments(&mb, segments, segment_count);
+
+    UXR_UNLOCK_STREAM_ID(
+      &custom_publisher->owner_node->context->session,
+      stream_id);
+    UXR_UNLOCK(&custom_publisher->mutex);
+
+    // Best effort samples never wait for acknowledgements, even when fragmented
+    if (UXR_BEST_EFFORT_STREAM == custom_publisher->stream_id.type) {
+      uxr_flash_output_streams(&custom_publisher->owner_node->context->session);
+    } else {
+      written &= run_session_until_stream_confirmed(
+        &custom_publisher->owner_node->context->session, stream_id,
+        custom_publisher->session_timeout);
+    }
+  } else {
+    UXR_UNLOCK(&custom_publisher->mutex);
+  }
+
+  if (!written) {
+    RMW_UROS_TRACE_MESSAGE("error publishing message")
+    return RMW_RET_ERROR;
+  }
+
+  rmw_uxrce_publisher_sample_published(custom_publisher);
+  return RMW_RET_OK;
+}
+
+#if RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+// Must be called with the allocation locked. The sample stays pending while the stream has no
+// room for it, false is only returned when it could not be serialized.
+static bool rmw_uxrce_publisher_allocation_send(
+  rmw_uxrce_publisher_allocation_t * publisher_allocation)
+{
+  rmw_uxrce_publisher_t * custom_publisher = publisher_allocation->publisher;
+  uxrSession * session = &custom_publisher->owner_node->context->session;
+  uint32_t topic_length = (uint32_t)publisher_allocation->length;
+  ucdrBuffer mb;
+
+  UXR_LOCK(&custom_publisher->mutex);
+  uxrStreamId stream_id = custom_publisher->stream_id;
+
+  // Never block, the sample is kept until the stream has room for it. Samples bigger than
+  // a slot are only written when all their fragments fit.
+  bool prepared = uxr_prepare_output_stream(
+    session, stream_id, custom_publisher->datawriter_id, &mb, topic_length);
+  if (!prepared) {
+    if (UXR_BEST_EFFORT_STREAM == stream_id.type) {
+      stream_id = rmw_uxrce_fragment_stream(custom_publisher);
+    }
+    prepared = rmw_uxrce_prepare_fragments(custom_publisher, &stream_id, &mb, topic_length);
+  }
+
+  publisher_allocation->pending = !prepared;
+
+  if (publisher_allocation->pending) {
+    UXR_UNLOCK(&custom_publisher->mutex);
+    return true;
+  }
+
+  bool written = ucdr_serialize_array_uint8_t(
+    &mb, publisher_allocation->buffer, publisher_allocation->length);
+
+  UXR_UNLOCK_STREAM_ID(session, stream_id);
+  UXR_UNLOCK(&custom_publisher->mutex);
+  uxr_flash_output_streams(session);
+
+  if (!written) {
+    RMW_UROS_TRACE_MESSAGE("error publishing message")
+  }
+
+  return written;
+}
+
+// Never blocks, not even for reliable publishers: RMW_RET_OK means that the sample has been
+// written to the output stream or kept until there is room for it, not that it is acknowledged
+static rmw_ret_t rmw_uxrce_publish_with_allocation(
+  rmw_uxrce_publisher_t * custom_publisher,
+  rmw_uxrce_publisher_allocation_t * publisher_allocation,
+  const void * ros_message)
+{
+  const message_type_support_callbacks_t * functions = custom_publisher->type_support_callbacks;
+
+  if (publisher_allocation->type_support_callbacks != functions) {
+    RMW_UROS_TRACE_MESSAGE("allocation not initialized for this message type")
+    return RMW_RET_ERROR;
+  }
+
+  uint32_t topic_length = functions->get_serialized_size(ros_message);
+
+  if (custom_publisher->cs_cb_size) {
+    custom_publisher->cs_cb_size(&topic_length);
+  }
+
+  // Samples bigger than a whole output stream take the regular path
+  if (topic_length > RMW_UXRCE_PUBLISHER_ALLOCATION_SIZE) {
+    return rmw_uxrce_publish(custom_publisher, ros_message, NULL, 0);
+  }
+
+  UXR_LOCK(&publisher_allocation->mutex);
+
+  // A sample still waiting for room in the stream is never overwritten. The pending samples
+  // have just been flushed, so the stream is still full and the new one is rejected.
+  if (publisher_allocation->pending) {
+    UXR_UNLOCK(&publisher_allocation->mutex);
+    RMW_UROS_TRACE_MESSAGE("previous sample of the allocation still pending")
+    return RMW_RET_ERROR;
+  }
+
+  ucdrBuffer mb;
+  ucdr_init_buffer(&mb, publisher_allocation->buffer, RMW_UXRCE_PUBLISHER_ALLOCATION_SIZE);
+
+  bool serialized = functions->cdr_serialize(ros_message, &mb);
+  if (custom_publisher->cs_cb_serialization) {
+    custom_publisher->cs_cb_serialization(&mb);
+  }
+
+  if (!serialized || mb.error) {
+    UXR_UNLOCK(&publisher_allocation->mutex);
+    RMW_UROS_TRACE_MESSAGE("error publishing message")
+    return RMW_RET_ERROR;
+  }
+
+  publisher_allocation->length = ucdr_buffer_length(&mb);
+  publisher_allocation->publisher = custom_publisher;
+
+#ifdef RMW_UXRCE_INTRAPROCESS
+  if (custom_publisher->local_only) {
+    rmw_uros_segment_t segment = {publisher_allocation->buffer, publisher_allocation->length};
+
+    if (!rmw_uxrce_intraprocess_publish(
+        custom_publisher, NULL, &segment, 1, publisher_allocation->length))
+    {
+      UXR_UNLOCK(&publisher_allocation->mutex);
+      RMW_UROS_TRACE_MESSAGE("error publishing message")
+      return RMW_RET_ERROR;
+    }
+  } else
+#endif  // RMW_UXRCE_INTRAPROCESS
+  if (!rmw_uxrce_publisher_allocation_send(publisher_allocation)) {
+    UXR_UNLOCK(&publisher_allocation->mutex);
+    return RMW_RET_ERROR;
+  }
+
+  UXR_UNLOCK(&publisher_allocation->mutex);
+
+  rmw_uxrce_publisher_sample_published(custom_publisher);
+  return RMW_RET_OK;
+}
+#endif  // RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+
+void rmw_uxrce_flush_publisher_allocations(void)
+{
+#if RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+  UXR_LOCK(&publisher_allocation_memory.mutex);
+
+  // Pending samples of higher priority classes get the free stream slots first
+  for (uint8_t priority_class = 0; priority_class < RMW_UXRCE_PRIORITY_CLASSES; priority_class++) {
+    rmw_uxrce_mempool_item_t * item = publisher_allocation_memory.allocateditems;
+    while (NULL != item) {
+      rmw_uxrce_publisher_allocation_t * publisher_allocation =
+        (rmw_uxrce_publisher_allocation_t *)item->data;
+
+      UXR_LOCK(&publisher_allocation->mutex);
+      if (publisher_allocation->pending &&
+        priority_class == publisher_allocation->publisher->priority_class)
+      {
+        // A sample that fails to serialize is dropped, there is no caller to report it to
+        rmw_uxrce_publisher_allocation_send(publisher_allocation);
+      }
+      UXR_UNLOCK(&publisher_allocation->mutex);
+
+      item = item->next;
+    }
+  }
+
+  UXR_UNLOCK(&publisher_allocation_memory.mutex);
+#endif  // RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
 }
 
 rmw_ret_t
@@ -34,7 +420,9 @@ rmw_publish(
   const void * ros_message,
   rmw_publisher_allocation_t * allocation)
 {
+#if RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS == 0
   (void)allocation;
+#endif  // RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS == 0
   rmw_ret_t ret = RMW_RET_OK;
   if (!publisher) {
     RMW_UROS_TRACE_MESSAGE("publisher pointer is null")
@@ -49,47 +437,83 @@ rmw_publish(
     RMW_UROS_TRACE_MESSAGE("publisher imp is null");
     ret = RMW_RET_ERROR;
   } else {
-    rmw_uxrce_publisher_t * custom_publisher = (rmw_uxrce_publisher_t *)publisher->data;
-    const message_type_support_callbacks_t * functions = custom_publisher->type_support_callbacks;
-    uint32_t topic_length = functions->get_serialized_size(ros_message);
+#if RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+    // Pending samples are sent on each publication too, not only when waiting
+    rmw_uxrce_flush_publisher_allocations();
 
-    if (custom_publisher->cs_cb_size) {
-      custom_publisher->cs_cb_size(&topic_length);
+    if (allocation && allocation->data &&
+      is_uxrce_rmw_identifier_valid(allocation->implementation_identifier))
+    {
+      ret = rmw_uxrce_publish_with_allocation(
+        (rmw_uxrce_publisher_t *)publisher->data,
+        (rmw_uxrce_publisher_allocation_t *)allocation->data, ros_message);
+    } else
+#endif  // RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+    {
+      ret = rmw_uxrce_publish(
+        (rmw_uxrce_publisher_t *)publisher->data, ros_message, NULL, 0);
     }
+  }
+  return ret;
+}
 
-    ucdrBuffer mb;
-    bool written = false;
-    if (uxr_prepare_output_stream(
-        &custom_publisher->owner_node->context->session,
-        custom_publisher->stream_id, custom_publisher->datawriter_id, &mb,
-        topic_length) ||
-      uxr_prepare_output_stream_fragmented(
-        &custom_publisher->owner_node->context->session,
-        custom_publisher->stream_id, custom_publisher->datawriter_id, &mb,
-        topic_length, flush_session, custom_publisher))
-    {
-      written = functions->cdr_serialize(ros_message, &mb);
-      if (custom_publisher->cs_cb_serialization) {
-        custom_publisher->cs_cb_serialization(&mb);
-      }
+rmw_ret_t
+rmw_uros_publish_segments(
+  const rmw_publisher_t * publisher,
+  const void * ros_message,
+  const rmw_uros_segment_t * segments,
+  size_t segment_count)
+{
+  rmw_ret_t ret = RMW_RET_OK;
+  if (!publisher) {
+    RMW_UROS_TRACE_MESSAGE("publisher pointer is null")
+    ret = RMW_RET_INVALID_ARGUMENT;
+  } else if (!ros_message) {
+    RMW_UROS_TRACE_MESSAGE("ros_message pointer is null")
+    ret = RMW_RET_INVALID_ARGUMENT;
+  } else if (!segments && segment_count > 0) {
+    RMW_UROS_TRACE_MESSAGE("segments pointer is null")
+    ret = RMW_RET_INVALID_ARGUMENT;
+  } else if (!is_uxrce_rmw_identifier_valid(publisher->implementation_identifier)) {
+    RMW_UROS_TRACE_MESSAGE("publisher handle not from this implementation")
+    ret = RMW_RET_INVALID_ARGUMENT;
+  } else if (!publisher->data) {
+    RMW_UROS_TRACE_MESSAGE("publisher imp is null")
+    ret = RMW_RET_INVALID_ARGUMENT;
+  } else {
+    ret = rmw_uxrce_publish(
+      (rmw_uxrce_publisher_t *)publisher->data, ros_message, segments, segment_count);
+  }
+  return ret;
+}
 
-      UXR_UNLOCK_STREAM_ID(
-        &custom_publisher->owner_node->context->session,
-        custom_publisher->stream_id);
+rmw_ret_t
+rmw_uros_publish_message_template(
+  rmw_uros_message_template_t * message_template,
+  const void * ros_message)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(message_template, RMW_RET_INVALID_ARGUMENT);
 
-      if (UXR_BEST_EFFORT_STREAM == custom_publisher->stream_id.type) {
-        uxr_flash_output_streams(&custom_publisher->owner_node->context->session);
-      } else {
-        written &= uxr_run_session_until_confirm_delivery(
-          &custom_publisher->owner_node->context->session, custom_publisher->session_timeout);
-      }
-    }
-    if (!written) {
-      RMW_UROS_TRACE_MESSAGE("error publishing message")
-      ret = RMW_RET_ERROR;
+  const rmw_publisher_t * publisher = message_template->publisher;
+  if (!publisher || !publisher->data || 0 == message_template->length) {
+    RMW_UROS_TRACE_MESSAGE("message template not initialized")
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  // Patch the recorded fields in place, their CDR representation is their memory one
+  if (NULL != ros_message) {
+    for (size_t i = 0; i < message_template->field_count; i++) {
+      const rmw_uros_message_template_field_t * field = &message_template->fields[i];
+      memcpy(
+        &message_template->buffer[field->cdr_offset],
+        (const uint8_t *)ros_message + field->member_offset,
+        field->size);
     }
   }
-  return ret;
+
+  rmw_uros_segment_t segment = {message_template->buffer, message_template->length};
+  return rmw_uxrce_publish(
+    (rmw_uxrce_publisher_t *)publisher->data, NULL, &segment, 1);
 }
 
 rmw_ret_t
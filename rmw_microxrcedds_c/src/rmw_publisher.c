@@ -30,8 +30,11 @@
 
 #include <rmw/allocators.h>
 #include <rmw/rmw.h>
+#include <uxr/client/util/time.h>
+#include <uxr/client/profile/multithread/multithread.h>
 
 #include "./rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/rmw_event.h"
 #include "./rmw_microros_internal/rmw_microxrcedds_topic.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
@@ -41,20 +44,165 @@ rmw_init_publisher_allocation(
   const rosidl_runtime_c__Sequence__bound * message_bounds,
   rmw_publisher_allocation_t * allocation)
 {
+#if RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+  // Serialization buffers are sized at build time to hold a whole output stream. The micro
+  // XRCE-DDS type support cannot apply sequence bounds, so the type maximum size is checked.
+  (void)message_bounds;
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_support, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_INVALID_ARGUMENT);
+
+  const rosidl_message_type_support_t * type_support_xrce = NULL;
+#ifdef ROSIDL_TYPESUPPORT_MICROXRCEDDS_C__IDENTIFIER_VALUE
+  type_support_xrce = get_message_typesupport_handle(
+    type_support, ROSIDL_TYPESUPPORT_MICROXRCEDDS_C__IDENTIFIER_VALUE);
+#endif /* ifdef ROSIDL_TYPESUPPORT_MICROXRCEDDS_C__IDENTIFIER_VALUE */
+#ifdef ROSIDL_TYPESUPPORT_MICROXRCEDDS_CPP__IDENTIFIER_VALUE
+  if (NULL == type_support_xrce) {
+    type_support_xrce = get_message_typesupport_handle(
+      type_support, ROSIDL_TYPESUPPORT_MICROXRCEDDS_CPP__IDENTIFIER_VALUE);
+  }
+#endif /* ifdef ROSIDL_TYPESUPPORT_MICROXRCEDDS_CPP__IDENTIFIER_VALUE */
+  if (NULL == type_support_xrce || NULL == type_support_xrce->data) {
+    RMW_UROS_TRACE_MESSAGE("Undefined type support")
+    return RMW_RET_ERROR;
+  }
+
+  const message_type_support_callbacks_t * functions =
+    (const message_type_support_callbacks_t *)type_support_xrce->data;
+
+  if (functions->max_serialized_size() > RMW_UXRCE_PUBLISHER_ALLOCATION_SIZE) {
+    RMW_UROS_TRACE_MESSAGE("message does not fit in a publisher allocation")
+    return RMW_RET_ERROR;
+  }
+
+  rmw_uxrce_mempool_item_t * memory_node = get_memory(&publisher_allocation_memory);
+  if (!memory_node) {
+    RMW_UROS_TRACE_MESSAGE("Not available memory node")
+    return RMW_RET_ERROR;
+  }
+
+  rmw_uxrce_publisher_allocation_t * publisher_allocation =
+    (rmw_uxrce_publisher_allocation_t *)memory_node->data;
+
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+  // Allocation slots are zero initialized and reused, so their mutex is only created once
+  if (!publisher_allocation->mutex_initialized) {
+    UXR_INIT_LOCK(&publisher_allocation->mutex);
+    publisher_allocation->mutex_initialized = true;
+  }
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+
+  publisher_allocation->type_support_callbacks = functions;
+  publisher_allocation->publisher = NULL;
+  publisher_allocation->pending = false;
+  publisher_allocation->length = 0;
+
+  allocation->implementation_identifier = rmw_get_implementation_identifier();
+  allocation->data = publisher_allocation;
+
+  return RMW_RET_OK;
+#else
   (void)type_support;
   (void)message_bounds;
   (void)allocation;
   RMW_UROS_TRACE_MESSAGE("function not implemented")
   return RMW_RET_UNSUPPORTED;
+#endif  // RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
 }
 
 rmw_ret_t
 rmw_fini_publisher_allocation(
   rmw_publisher_allocation_t * allocation)
 {
+#if RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+  RMW_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_INVALID_ARGUMENT);
+
+  if (!is_uxrce_rmw_identifier_valid(allocation->implementation_identifier) ||
+    NULL == allocation->data)
+  {
+    RMW_UROS_TRACE_MESSAGE("allocation not from this implementation")
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  rmw_uxrce_publisher_allocation_t * publisher_allocation =
+    (rmw_uxrce_publisher_allocation_t *)allocation->data;
+
+  // A sample still waiting for room in the stream is dropped
+  UXR_LOCK(&publisher_allocation->mutex);
+  publisher_allocation->pending = false;
+  publisher_allocation->publisher = NULL;
+  UXR_UNLOCK(&publisher_allocation->mutex);
+
+  put_memory(&publisher_allocation_memory, &publisher_allocation->mem);
+
+  allocation->implementation_identifier = NULL;
+  allocation->data = NULL;
+
+  return RMW_RET_OK;
+#else
   (void)allocation;
   RMW_UROS_TRACE_MESSAGE("function not implemented")
   return RMW_RET_UNSUPPORTED;
+#endif  // RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+}
+
+uint16_t buffer_publisher_creation(
+  rmw_uxrce_publisher_t * custom_publisher)
+{
+  rmw_uxrce_node_t * custom_node = custom_publisher->owner_node;
+  uint16_t publisher_req = UXR_INVALID_REQUEST_ID;
+
+#ifdef RMW_UXRCE_USE_REFS
+  publisher_req = uxr_buffer_create_publisher_xml(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream,
+    custom_publisher->publisher_id,
+    custom_node->participant_id, "", UXR_REPLACE | UXR_REUSE);
+#else
+  publisher_req = uxr_buffer_create_publisher_bin(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream,
+    custom_publisher->publisher_id,
+    custom_node->participant_id,
+    UXR_REPLACE | UXR_REUSE);
+#endif /* ifdef RMW_UXRCE_USE_REFS */
+
+  return publisher_req;
+}
+
+uint16_t buffer_datawriter_creation(
+  rmw_uxrce_publisher_t * custom_publisher)
+{
+  rmw_uxrce_node_t * custom_node = custom_publisher->owner_node;
+  uint16_t datawriter_req = UXR_INVALID_REQUEST_ID;
+
+#ifdef RMW_UXRCE_USE_REFS
+  if (!build_datawriter_profile(
+      custom_publisher->topic_name, custom_node->context->entity_naming_buffer,
+      sizeof(custom_node->context->entity_naming_buffer)))
+  {
+    RMW_UROS_TRACE_MESSAGE("failed to generate xml request for node creation")
+    return UXR_INVALID_REQUEST_ID;
+  }
+
+  datawriter_req = uxr_buffer_create_datawriter_ref(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream,
+    custom_publisher->datawriter_id,
+    custom_publisher->publisher_id, custom_node->context->entity_naming_buffer,
+    UXR_REPLACE | UXR_REUSE);
+#else
+  datawriter_req = uxr_buffer_create_datawriter_bin(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream,
+    custom_publisher->datawriter_id,
+    custom_publisher->publisher_id,
+    custom_publisher->topic->topic_id,
+    convert_qos_profile(&custom_publisher->qos),
+    UXR_REPLACE | UXR_REUSE);
+#endif /* ifdef RMW_UXRCE_USE_REFS */
+
+  return datawriter_req;
 }
 
 rmw_publisher_t *
@@ -88,6 +236,22 @@ rmw_create_publisher(
     }
     custom_publisher = (rmw_uxrce_publisher_t *)memory_node->data;
 
+    custom_publisher->owner_node = custom_node;
+    custom_publisher->topic = NULL;
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+    if (!custom_publisher->mutex_initialized) {
+      UXR_INIT_LOCK(&custom_publisher->mutex);
+      custom_publisher->mutex_initialized = true;
+    }
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+    rmw_uxrce_init_event_status(&custom_publisher->deadline_missed);
+    custom_publisher->deadline_start = uxr_nanos();
+#ifdef RMW_UXRCE_INTRAPROCESS
+    custom_publisher->local_only = false;
+#endif  // RMW_UXRCE_INTRAPROCESS
+    custom_publisher->publisher_id = uxr_object_id(0, UXR_INVALID_ID);
+    custom_publisher->datawriter_id = uxr_object_id(0, UXR_INVALID_ID);
+
     rmw_publisher = &custom_publisher->rmw_publisher;
     rmw_publisher->data = custom_publisher;
     rmw_publisher->implementation_identifier = rmw_get_implementation_identifier();
@@ -101,9 +265,9 @@ rmw_create_publisher(
       (char *)rmw_publisher->topic_name, sizeof(custom_publisher->topic_name), "%s",
       topic_name);
 
-    custom_publisher->owner_node = custom_node;
     custom_publisher->session_timeout = RMW_UXRCE_PUBLISH_RELIABLE_TIMEOUT;
     custom_publisher->qos = *qos_policies;
+    custom_publisher->priority_class = 0;
 
     custom_publisher->stream_id =
       (qos_policies->reliability == RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT) ?
@@ -139,7 +303,7 @@ rmw_create_publisher(
 
     // Create topic
     custom_publisher->topic = create_topic(
-      custom_node, topic_name,
+      custom_node, custom_publisher->topic_name,
       custom_publisher->type_support_callbacks, qos_policies);
 
     if (custom_publisher->topic == NULL) {
@@ -148,67 +312,29 @@ rmw_create_publisher(
     }
 
     // Create publisher
-    custom_publisher->publisher_id = uxr_object_id(
-      custom_node->context->id_publisher++,
-      UXR_PUBLISHER_ID);
-    uint16_t publisher_req = UXR_INVALID_REQUEST_ID;
-
-  #ifdef RMW_UXRCE_USE_REFS
-    publisher_req = uxr_buffer_create_publisher_xml(
-      &custom_publisher->owner_node->context->session,
-      *custom_node->context->creation_stream,
-      custom_publisher->publisher_id,
-      custom_node->participant_id, "", UXR_REPLACE | UXR_REUSE);
-  #else
-    publisher_req = uxr_buffer_create_publisher_bin(
-      &custom_publisher->owner_node->context->session,
-      *custom_node->context->creation_stream,
-      custom_publisher->publisher_id,
-      custom_node->participant_id,
-      UXR_REPLACE | UXR_REUSE);
-  #endif /* ifdef RMW_UXRCE_USE_REFS */
-
-    if (!run_xrce_session(
-        custom_node->context, custom_node->context->creation_stream, publisher_req,
-        custom_node->context->creation_timeout))
+    if (!acquire_xrce_object_id(
+        custom_node->context, UXR_PUBLISHER_ID, &custom_publisher->publisher_id))
+    {
+      goto fail;
+    }
+    uint16_t publisher_req = buffer_publisher_creation(custom_publisher);
+
+    if (!run_xrce_creation(
+        custom_node->context, &custom_publisher->publisher_id, topic_name, publisher_req))
     {
       goto fail;
     }
 
     // Create datawriter
-    custom_publisher->datawriter_id = uxr_object_id(
-      custom_node->context->id_datawriter++,
-      UXR_DATAWRITER_ID);
-    uint16_t datawriter_req = UXR_INVALID_REQUEST_ID;
-
-  #ifdef RMW_UXRCE_USE_REFS
-    if (!build_datawriter_profile(
-        topic_name, rmw_uxrce_entity_naming_buffer,
-        sizeof(rmw_uxrce_entity_naming_buffer)))
+    if (!acquire_xrce_object_id(
+        custom_node->context, UXR_DATAWRITER_ID, &custom_publisher->datawriter_id))
     {
-      RMW_UROS_TRACE_MESSAGE("failed to generate xml request for node creation")
       goto fail;
     }
+    uint16_t datawriter_req = buffer_datawriter_creation(custom_publisher);
 
-    datawriter_req = uxr_buffer_create_datawriter_ref(
-      &custom_publisher->owner_node->context->session,
-      *custom_node->context->creation_stream,
-      custom_publisher->datawriter_id,
-      custom_publisher->publisher_id, rmw_uxrce_entity_naming_buffer, UXR_REPLACE | UXR_REUSE);
-  #else
-    datawriter_req = uxr_buffer_create_datawriter_bin(
-      &custom_publisher->owner_node->context->session,
-      *custom_node->context->creation_stream,
-      custom_publisher->datawriter_id,
-      custom_publisher->publisher_id,
-      custom_publisher->topic->topic_id,
-      convert_qos_profile(qos_policies),
-      UXR_REPLACE | UXR_REUSE);
-  #endif /* ifdef RMW_UXRCE_USE_REFS */
-
-    if (!run_xrce_session(
-        custom_node->context, custom_node->context->creation_stream, datawriter_req,
-        custom_node->context->creation_timeout))
+    if (!run_xrce_creation(
+        custom_node->context, &custom_publisher->datawriter_id, topic_name, datawriter_req))
     {
       goto fail;
     }
@@ -216,8 +342,15 @@ rmw_create_publisher(
 
   return rmw_publisher;
 fail:
-  if (custom_publisher != NULL && custom_publisher->topic != NULL) {
-    rmw_uxrce_fini_topic_memory(custom_publisher->topic);
+  if (custom_publisher != NULL) {
+    rmw_context_impl_t * context = custom_publisher->owner_node->context;
+    release_xrce_object_id(context, &custom_publisher->datawriter_id);
+    release_xrce_object_id(context, &custom_publisher->publisher_id);
+
+    if (custom_publisher->topic != NULL) {
+      release_xrce_object_id(context, &custom_publisher->topic->topic_id);
+      rmw_uxrce_fini_topic_memory(custom_publisher->topic);
+    }
   }
 
   rmw_uxrce_fini_publisher_memory(rmw_publisher);
@@ -347,22 +480,14 @@ rmw_destroy_publisher(
 
     destroy_topic(custom_publisher->topic);
 
-    uint16_t delete_writer = uxr_buffer_delete_entity(
-      &custom_publisher->owner_node->context->session,
-      *custom_publisher->owner_node->context->destroy_stream,
-      custom_publisher->datawriter_id);
-    uint16_t delete_publisher = uxr_buffer_delete_entity(
-      &custom_publisher->owner_node->context->session,
-      *custom_publisher->owner_node->context->destroy_stream,
-      custom_publisher->publisher_id);
-
-    bool ret = run_xrce_session(
-      custom_node->context, custom_node->context->destroy_stream, delete_writer,
-      custom_node->context->destroy_timeout);
-    ret &= run_xrce_session(
-      custom_node->context, custom_node->context->destroy_stream, delete_publisher,
-      custom_node->context->destroy_timeout);
-    if (!ret) {
+    const uxrObjectId entities[] = {
+      custom_publisher->datawriter_id, custom_publisher->publisher_id
+    };
+
+    if (!run_xrce_deletion(
+        custom_node->context, false, entities,
+        sizeof(entities) / sizeof(entities[0])))
+    {
       result_ret = RMW_RET_TIMEOUT;
     }
 
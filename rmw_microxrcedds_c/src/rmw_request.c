@@ -80,21 +80,13 @@ rmw_take_request(
 
   rmw_uxrce_service_t * custom_service = (rmw_uxrce_service_t *)service->data;
 
-  rmw_uxrce_clean_expired_static_input_buffer();
-
-  UXR_LOCK(&static_buffer_memory.mutex);
-
-  // Find first related item in static buffer memory pool
-  rmw_uxrce_mempool_item_t * static_buffer_item =
-    rmw_uxrce_find_static_input_buffer_by_owner((void *) custom_service);
-  if (static_buffer_item == NULL) {
-    UXR_UNLOCK(&static_buffer_memory.mutex);
+  // Take the oldest sample, it is deserialized out of the queue lock
+  rmw_uxrce_static_input_buffer_t * static_buffer = rmw_uxrce_input_queue_pop(
+    &custom_service->input_queue, &custom_service->qos);
+  if (static_buffer == NULL) {
     return RMW_RET_ERROR;
   }
 
-  rmw_uxrce_static_input_buffer_t * static_buffer =
-    (rmw_uxrce_static_input_buffer_t *)static_buffer_item->data;
-
   // Conversion from SampleIdentity to rmw_request_id_t
   request_header->request_id.sequence_number =
     (((int64_t)static_buffer->related.sample_id.sequence_number.high) << 32) |
@@ -123,9 +115,7 @@ rmw_take_request(
 
   bool deserialize_rv = functions->cdr_deserialize(&temp_buffer, ros_request);
 
-  put_memory(&static_buffer_memory, static_buffer_item);
-
-  UXR_UNLOCK(&static_buffer_memory.mutex);
+  rmw_uxrce_put_static_input_buffer(static_buffer);
 
   if (taken != NULL) {
     *taken = deserialize_rv;
@@ -94,21 +94,13 @@ rmw_take_response(
 
   rmw_uxrce_client_t * custom_client = (rmw_uxrce_client_t *)client->data;
 
-  rmw_uxrce_clean_expired_static_input_buffer();
-
-  UXR_LOCK(&static_buffer_memory.mutex);
-
-  // Find first related item in static buffer memory pool
-  rmw_uxrce_mempool_item_t * static_buffer_item =
-    rmw_uxrce_find_static_input_buffer_by_owner((void *) custom_client);
-  if (static_buffer_item == NULL) {
-    UXR_UNLOCK(&static_buffer_memory.mutex);
+  // Take the oldest sample, it is deserialized out of the queue lock
+  rmw_uxrce_static_input_buffer_t * static_buffer = rmw_uxrce_input_queue_pop(
+    &custom_client->input_queue, &custom_client->qos);
+  if (static_buffer == NULL) {
     return RMW_RET_ERROR;
   }
 
-  rmw_uxrce_static_input_buffer_t * static_buffer =
-    (rmw_uxrce_static_input_buffer_t *)static_buffer_item->data;
-
   request_header->request_id.sequence_number = static_buffer->related.reply_id;
 
   const rosidl_message_type_support_t * res_members =
@@ -126,9 +118,7 @@ rmw_take_response(
     &temp_buffer,
     ros_response);
 
-  put_memory(&static_buffer_memory, static_buffer_item);
-
-  UXR_UNLOCK(&static_buffer_memory.mutex);
+  rmw_uxrce_put_static_input_buffer(static_buffer);
 
   if (taken != NULL) {
     *taken = deserialize_rv;
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "./rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/rmw_service.h"
 
 #ifdef HAVE_C_TYPESUPPORT
 #include <rosidl_typesupport_microxrcedds_c/identifier.h>
@@ -26,6 +27,93 @@
 
 #include "./rmw_microros_internal/error_handling_internal.h"
 
+uint16_t buffer_replier_creation(
+  rmw_uxrce_service_t * custom_service)
+{
+  rmw_uxrce_node_t * custom_node = custom_service->owner_node;
+  uint16_t service_req = UXR_INVALID_REQUEST_ID;
+
+#ifdef RMW_UXRCE_USE_REFS
+  // TODO(pablogs9): Use here true references
+  // service_req = uxr_buffer_create_replier_ref(&custom_node->context->session,
+  //     *custom_node->context->creation_stream, custom_service->subscriber_id,
+  //     custom_node->participant_id, "", UXR_REPLACE | UXR_REUSE);
+  char service_name_id[20];
+  generate_name(&custom_service->service_id, service_name_id, sizeof(service_name_id));
+  if (!build_service_xml(
+      service_name_id, custom_service->service_name, false,
+      custom_service->type_support_callbacks, &custom_service->qos,
+      custom_node->context->entity_naming_buffer,
+      sizeof(custom_node->context->entity_naming_buffer)))
+  {
+    RMW_UROS_TRACE_MESSAGE("failed to generate xml request for service creation")
+    return UXR_INVALID_REQUEST_ID;
+  }
+  service_req = uxr_buffer_create_replier_xml(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream, custom_service->service_id,
+    custom_node->participant_id, custom_node->context->entity_naming_buffer,
+    UXR_REPLACE | UXR_REUSE);
+#else
+  char req_type_name[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
+  char res_type_name[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
+  if (!generate_service_types(
+      custom_service->type_support_callbacks, req_type_name, res_type_name,
+      RMW_UXRCE_TYPE_NAME_MAX_LENGTH))
+  {
+    RMW_UROS_TRACE_MESSAGE("Not enough memory for service type names")
+    return UXR_INVALID_REQUEST_ID;
+  }
+
+  char req_topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
+  char res_topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
+  if (!generate_service_topics(
+      custom_service->service_name, req_topic_name, res_topic_name,
+      RMW_UXRCE_TOPIC_NAME_MAX_LENGTH))
+  {
+    RMW_UROS_TRACE_MESSAGE("Not enough memory for service topic names")
+    return UXR_INVALID_REQUEST_ID;
+  }
+
+  service_req = uxr_buffer_create_replier_bin(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream,
+    custom_service->service_id,
+    custom_node->participant_id,
+    (char *) custom_service->service_name,
+    req_type_name,
+    res_type_name,
+    req_topic_name,
+    res_topic_name,
+    convert_qos_profile(&custom_service->qos),
+    UXR_REPLACE | UXR_REUSE);
+#endif /* ifdef RMW_UXRCE_USE_XML */
+
+  return service_req;
+}
+
+uint16_t buffer_service_data_request(
+  rmw_uxrce_service_t * custom_service)
+{
+  rmw_uxrce_node_t * custom_node = custom_service->owner_node;
+
+  uxrDeliveryControl delivery_control;
+  delivery_control.max_samples = UXR_MAX_SAMPLES_UNLIMITED;
+  delivery_control.min_pace_period = 0;
+  delivery_control.max_elapsed_time = UXR_MAX_ELAPSED_TIME_UNLIMITED;
+  delivery_control.max_bytes_per_second = UXR_MAX_BYTES_PER_SECOND_UNLIMITED;
+
+  uxrStreamId data_request_stream_id =
+    (custom_service->qos.reliability == RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT) ?
+    custom_node->context->best_effort_input :
+    custom_node->context->reliable_input;
+
+  return uxr_buffer_request_data(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream, custom_service->service_id,
+    data_request_stream_id, &delivery_control);
+}
+
 rmw_service_t *
 rmw_create_service(
   const rmw_node_t * node,
@@ -33,6 +121,7 @@ rmw_create_service(
   const char * service_name,
   const rmw_qos_profile_t * qos_policies)
 {
+  rmw_uxrce_service_t * custom_service = NULL;
   rmw_service_t * rmw_service = NULL;
   if (!node) {
     RMW_UROS_TRACE_MESSAGE("node handle is null")
@@ -51,7 +140,11 @@ rmw_create_service(
       RMW_UROS_TRACE_MESSAGE("Not available memory node")
       return NULL;
     }
-    rmw_uxrce_service_t * custom_service = (rmw_uxrce_service_t *)memory_node->data;
+    custom_service = (rmw_uxrce_service_t *)memory_node->data;
+
+    custom_service->owner_node = custom_node;
+    rmw_uxrce_init_input_queue(&custom_service->input_queue);
+    custom_service->service_id = uxr_object_id(0, UXR_INVALID_ID);
 
     rmw_service = &custom_service->rmw_service;
     rmw_service->data = custom_service;
@@ -64,7 +157,6 @@ rmw_create_service(
 
     memcpy((void *)rmw_service->service_name, service_name, strlen(service_name) + 1);
 
-    custom_service->owner_node = custom_node;
     custom_service->session_timeout = RMW_UXRCE_PUBLISH_RELIABLE_TIMEOUT;
     custom_service->qos = *qos_policies;
 
@@ -92,96 +184,35 @@ rmw_create_service(
       goto fail;
     }
 
-    custom_service->service_id = uxr_object_id(custom_node->context->id_replier++, UXR_REPLIER_ID);
-
-    uint16_t service_req = UXR_INVALID_REQUEST_ID;
-
-#ifdef RMW_UXRCE_USE_REFS
-    // TODO(pablogs9): Use here true references
-    // service_req = uxr_buffer_create_replier_ref(&custom_node->context->session,
-    //     *custom_node->context->creation_stream, custom_service->subscriber_id,
-    //     custom_node->participant_id, "", UXR_REPLACE | UXR_REUSE);
-    char service_name_id[20];
-    generate_name(&custom_service->service_id, service_name_id, sizeof(service_name_id));
-    if (!build_service_xml(
-        service_name_id, service_name, false,
-        custom_service->type_support_callbacks, qos_policies, rmw_uxrce_entity_naming_buffer,
-        sizeof(rmw_uxrce_entity_naming_buffer)))
-    {
-      RMW_UROS_TRACE_MESSAGE("failed to generate xml request for service creation")
-      goto fail;
-    }
-    service_req = uxr_buffer_create_replier_xml(
-      &custom_node->context->session,
-      *custom_node->context->creation_stream, custom_service->service_id,
-      custom_node->participant_id, rmw_uxrce_entity_naming_buffer, UXR_REPLACE | UXR_REUSE);
-#else
-    static char req_type_name[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
-    static char res_type_name[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
-    if (!generate_service_types(
-        custom_service->type_support_callbacks, req_type_name, res_type_name,
-        RMW_UXRCE_TYPE_NAME_MAX_LENGTH))
+    if (!acquire_xrce_object_id(
+        custom_node->context, UXR_REPLIER_ID, &custom_service->service_id))
     {
-      RMW_UROS_TRACE_MESSAGE("Not enough memory for service type names")
       goto fail;
     }
 
-    static char req_topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
-    static char res_topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH];
-    if (!generate_service_topics(
-        service_name, req_topic_name, res_topic_name,
-        RMW_UXRCE_TOPIC_NAME_MAX_LENGTH))
-    {
-      RMW_UROS_TRACE_MESSAGE("Not enough memory for service topic names")
-      goto fail;
-    }
+    uint16_t service_req = buffer_replier_creation(custom_service);
 
-    service_req = uxr_buffer_create_replier_bin(
-      &custom_node->context->session,
-      *custom_node->context->creation_stream,
-      custom_service->service_id,
-      custom_node->participant_id,
-      (char *) service_name,
-      req_type_name,
-      res_type_name,
-      req_topic_name,
-      res_topic_name,
-      convert_qos_profile(qos_policies),
-      UXR_REPLACE | UXR_REUSE);
-#endif /* ifdef RMW_UXRCE_USE_XML */
-
-    if (!run_xrce_session(
-        custom_node->context, custom_node->context->creation_stream, service_req,
-        custom_node->context->creation_timeout))
+    if (!run_xrce_creation(
+        custom_node->context, &custom_service->service_id, service_name, service_req))
     {
       RMW_UROS_TRACE_MESSAGE("Issues creating Micro XRCE-DDS entities")
       goto fail;
     }
 
-    uxrDeliveryControl delivery_control;
-    delivery_control.max_samples = UXR_MAX_SAMPLES_UNLIMITED;
-    delivery_control.min_pace_period = 0;
-    delivery_control.max_elapsed_time = UXR_MAX_ELAPSED_TIME_UNLIMITED;
-    delivery_control.max_bytes_per_second = UXR_MAX_BYTES_PER_SECOND_UNLIMITED;
-
     custom_service->stream_id =
       (qos_policies->reliability == RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT) ?
       custom_node->context->best_effort_output :
       custom_node->context->reliable_output;
 
-    uxrStreamId data_request_stream_id =
-      (qos_policies->reliability == RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT) ?
-      custom_node->context->best_effort_input :
-      custom_node->context->reliable_input;
-
-    custom_service->service_data_resquest = uxr_buffer_request_data(
-      &custom_node->context->session,
-      *custom_node->context->creation_stream, custom_service->service_id,
-      data_request_stream_id, &delivery_control);
+    custom_service->service_data_resquest = buffer_service_data_request(custom_service);
   }
   return rmw_service;
 
 fail:
+  if (custom_service != NULL) {
+    release_xrce_object_id(custom_service->owner_node->context, &custom_service->service_id);
+  }
+
   rmw_uxrce_fini_service_memory(rmw_service);
   rmw_service = NULL;
   return rmw_service;
@@ -215,24 +246,8 @@ rmw_destroy_service(
     rmw_uxrce_node_t * custom_node = (rmw_uxrce_node_t *)node->data;
     rmw_uxrce_service_t * custom_service = (rmw_uxrce_service_t *)service->data;
 
-    uint16_t service_req = uxr_buffer_cancel_data(
-      &custom_node->context->session,
-      *custom_node->context->destroy_stream,
-      custom_service->service_id);
-
-    run_xrce_session(
-      custom_node->context, custom_node->context->destroy_stream, service_req,
-      custom_node->context->destroy_timeout);
-
-    uint16_t delete_service =
-      uxr_buffer_delete_entity(
-      &custom_node->context->session,
-      *custom_node->context->destroy_stream,
-      custom_service->service_id);
-
-    if (!run_xrce_session(
-        custom_node->context, custom_node->context->destroy_stream, delete_service,
-        custom_node->context->destroy_timeout))
+    if (!run_xrce_deletion(
+        custom_node->context, true, &custom_service->service_id, 1))
     {
       result_ret = RMW_RET_TIMEOUT;
     }
@@ -28,8 +28,11 @@
 #include <rmw/rmw.h>
 #include <rmw/types.h>
 #include <rmw/allocators.h>
+#include <uxr/client/util/time.h>
 
 #include "./rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/rmw_event.h"
+#include "./rmw_microros_internal/rmw_subscription.h"
 #include "./rmw_microros_internal/rmw_microxrcedds_topic.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
@@ -39,20 +42,170 @@ rmw_init_subscription_allocation(
   const rosidl_runtime_c__Sequence__bound * message_bounds,
   rmw_subscription_allocation_t * allocation)
 {
+#if RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+  // Deserialization buffers are sized at build time to hold a whole input stream. The micro
+  // XRCE-DDS type support cannot apply sequence bounds, so the type maximum size is checked.
+  (void)message_bounds;
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_support, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_INVALID_ARGUMENT);
+
+  // Only the C type support deserializes without touching the heap
+  const rosidl_message_type_support_t * type_support_xrce = NULL;
+#ifdef ROSIDL_TYPESUPPORT_MICROXRCEDDS_C__IDENTIFIER_VALUE
+  type_support_xrce = get_message_typesupport_handle(
+    type_support, ROSIDL_TYPESUPPORT_MICROXRCEDDS_C__IDENTIFIER_VALUE);
+#endif /* ifdef ROSIDL_TYPESUPPORT_MICROXRCEDDS_C__IDENTIFIER_VALUE */
+  if (NULL == type_support_xrce || NULL == type_support_xrce->data) {
+    RMW_UROS_TRACE_MESSAGE("subscription allocations require the C type support")
+    return RMW_RET_UNSUPPORTED;
+  }
+
+  const message_type_support_callbacks_t * functions =
+    (const message_type_support_callbacks_t *)type_support_xrce->data;
+
+  if (functions->max_serialized_size() > RMW_UXRCE_SUBSCRIPTION_ALLOCATION_SIZE) {
+    RMW_UROS_TRACE_MESSAGE("message does not fit in a subscription allocation")
+    return RMW_RET_ERROR;
+  }
+
+  rmw_uxrce_mempool_item_t * memory_node = get_memory(&subscription_allocation_memory);
+  if (!memory_node) {
+    RMW_UROS_TRACE_MESSAGE("Not available memory node")
+    return RMW_RET_ERROR;
+  }
+
+  rmw_uxrce_subscription_allocation_t * subscription_allocation =
+    (rmw_uxrce_subscription_allocation_t *)memory_node->data;
+
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+  // Allocation slots are zero initialized and reused, so their mutex is only created once
+  if (!subscription_allocation->mutex_initialized) {
+    UXR_INIT_LOCK(&subscription_allocation->mutex);
+    subscription_allocation->mutex_initialized = true;
+  }
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+
+  subscription_allocation->type_support_callbacks = functions;
+
+  allocation->implementation_identifier = rmw_get_implementation_identifier();
+  allocation->data = subscription_allocation;
+
+  return RMW_RET_OK;
+#else
   (void)type_support;
   (void)message_bounds;
   (void)allocation;
   RMW_UROS_TRACE_MESSAGE("function not implemented")
   return RMW_RET_UNSUPPORTED;
+#endif  // RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
 }
 
 rmw_ret_t
 rmw_fini_subscription_allocation(
   rmw_subscription_allocation_t * allocation)
 {
+#if RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+  RMW_CHECK_ARGUMENT_FOR_NULL(allocation, RMW_RET_INVALID_ARGUMENT);
+
+  if (!is_uxrce_rmw_identifier_valid(allocation->implementation_identifier) ||
+    NULL == allocation->data)
+  {
+    RMW_UROS_TRACE_MESSAGE("allocation not from this implementation")
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  rmw_uxrce_subscription_allocation_t * subscription_allocation =
+    (rmw_uxrce_subscription_allocation_t *)allocation->data;
+  put_memory(&subscription_allocation_memory, &subscription_allocation->mem);
+
+  allocation->implementation_identifier = NULL;
+  allocation->data = NULL;
+
+  return RMW_RET_OK;
+#else
   (void)allocation;
   RMW_UROS_TRACE_MESSAGE("function not implemented")
   return RMW_RET_UNSUPPORTED;
+#endif  // RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+}
+
+uint16_t buffer_subscriber_creation(
+  rmw_uxrce_subscription_t * custom_subscription)
+{
+  rmw_uxrce_node_t * custom_node = custom_subscription->owner_node;
+  uint16_t subscriber_req = UXR_INVALID_REQUEST_ID;
+
+#ifdef RMW_UXRCE_USE_REFS
+  subscriber_req = uxr_buffer_create_subscriber_xml(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream, custom_subscription->subscriber_id,
+    custom_node->participant_id, "", UXR_REPLACE | UXR_REUSE);
+#else
+  subscriber_req = uxr_buffer_create_subscriber_bin(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream,
+    custom_subscription->subscriber_id,
+    custom_node->participant_id,
+    UXR_REPLACE | UXR_REUSE);
+#endif /* ifdef RMW_UXRCE_USE_REFS */
+
+  return subscriber_req;
+}
+
+uint16_t buffer_datareader_creation(
+  rmw_uxrce_subscription_t * custom_subscription)
+{
+  rmw_uxrce_node_t * custom_node = custom_subscription->owner_node;
+  uint16_t datareader_req = UXR_INVALID_REQUEST_ID;
+
+#ifdef RMW_UXRCE_USE_REFS
+  if (!build_datareader_profile(
+      custom_subscription->topic_name, custom_node->context->entity_naming_buffer,
+      sizeof(custom_node->context->entity_naming_buffer)))
+  {
+    RMW_UROS_TRACE_MESSAGE("failed to generate xml request for node creation")
+    return UXR_INVALID_REQUEST_ID;
+  }
+
+  datareader_req = uxr_buffer_create_datareader_ref(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream, custom_subscription->datareader_id,
+    custom_subscription->subscriber_id, custom_node->context->entity_naming_buffer,
+    UXR_REPLACE | UXR_REUSE);
+#else
+  datareader_req = uxr_buffer_create_datareader_bin(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream,
+    custom_subscription->datareader_id,
+    custom_subscription->subscriber_id,
+    custom_subscription->topic->topic_id,
+    convert_qos_profile(&custom_subscription->qos),
+    UXR_REPLACE | UXR_REUSE);
+#endif /* ifdef RMW_UXRCE_USE_XML */
+
+  return datareader_req;
+}
+
+uint16_t buffer_subscription_data_request(
+  rmw_uxrce_subscription_t * custom_subscription)
+{
+  rmw_uxrce_node_t * custom_node = custom_subscription->owner_node;
+
+  uxrDeliveryControl delivery_control;
+  delivery_control.max_samples = UXR_MAX_SAMPLES_UNLIMITED;
+  delivery_control.min_pace_period = 0;
+  delivery_control.max_elapsed_time = UXR_MAX_ELAPSED_TIME_UNLIMITED;
+  delivery_control.max_bytes_per_second = UXR_MAX_BYTES_PER_SECOND_UNLIMITED;
+
+  uxrStreamId data_request_stream_id =
+    (custom_subscription->qos.reliability == RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT) ?
+    custom_node->context->best_effort_input :
+    custom_node->context->reliable_input;
+
+  return uxr_buffer_request_data(
+    &custom_node->context->session,
+    *custom_node->context->creation_stream, custom_subscription->datareader_id,
+    data_request_stream_id, &delivery_control);
 }
 
 rmw_subscription_t *
@@ -88,6 +241,18 @@ rmw_create_subscription(
     }
     custom_subscription = (rmw_uxrce_subscription_t *)memory_node->data;
 
+    custom_subscription->owner_node = custom_node;
+    rmw_uxrce_init_input_queue(&custom_subscription->input_queue);
+    custom_subscription->user_buffer.data = NULL;
+    custom_subscription->user_buffer.size = 0;
+    custom_subscription->user_buffer.in_use = false;
+    rmw_uxrce_init_event_status(&custom_subscription->message_lost);
+    rmw_uxrce_init_event_status(&custom_subscription->deadline_missed);
+    custom_subscription->deadline_start = uxr_nanos();
+    custom_subscription->topic = NULL;
+    custom_subscription->subscriber_id = uxr_object_id(0, UXR_INVALID_ID);
+    custom_subscription->datareader_id = uxr_object_id(0, UXR_INVALID_ID);
+
     rmw_subscription = &custom_subscription->rmw_subscription;
     rmw_subscription->data = custom_subscription;
     rmw_subscription->implementation_identifier = rmw_get_implementation_identifier();
@@ -101,7 +266,6 @@ rmw_create_subscription(
       (char *)rmw_subscription->topic_name, sizeof(custom_subscription->topic_name), "%s",
       topic_name);
 
-    custom_subscription->owner_node = custom_node;
     custom_subscription->qos = *qos_policies;
 
     const rosidl_message_type_support_t * type_support_xrce = NULL;
@@ -130,98 +294,55 @@ rmw_create_subscription(
 
     // Create topic
     custom_subscription->topic = create_topic(
-      custom_node, topic_name,
+      custom_node, custom_subscription->topic_name,
       custom_subscription->type_support_callbacks, qos_policies);
     if (custom_subscription->topic == NULL) {
       goto fail;
     }
 
     // Create subscriber
-    custom_subscription->subscriber_id = uxr_object_id(
-      custom_node->context->id_subscriber++,
-      UXR_SUBSCRIBER_ID);
-    uint16_t subscriber_req = UXR_INVALID_REQUEST_ID;
-
-#ifdef RMW_UXRCE_USE_REFS
-    subscriber_req = uxr_buffer_create_subscriber_xml(
-      &custom_node->context->session,
-      *custom_node->context->creation_stream, custom_subscription->subscriber_id,
-      custom_node->participant_id, "", UXR_REPLACE | UXR_REUSE);
-#else
-    subscriber_req = uxr_buffer_create_subscriber_bin(
-      &custom_node->context->session,
-      *custom_node->context->creation_stream,
-      custom_subscription->subscriber_id,
-      custom_node->participant_id,
-      UXR_REPLACE | UXR_REUSE);
-#endif /* ifdef RMW_UXRCE_USE_REFS */
+    if (!acquire_xrce_object_id(
+        custom_node->context, UXR_SUBSCRIBER_ID, &custom_subscription->subscriber_id))
+    {
+      goto fail;
+    }
+    uint16_t subscriber_req = buffer_subscriber_creation(custom_subscription);
 
-    if (!run_xrce_session(
-        custom_node->context, custom_node->context->creation_stream, subscriber_req,
-        custom_node->context->creation_timeout))
+    if (!run_xrce_creation(
+        custom_node->context, &custom_subscription->subscriber_id, topic_name, subscriber_req))
     {
       goto fail;
     }
 
     // Create datareader
-    custom_subscription->datareader_id = uxr_object_id(
-      custom_node->context->id_datareader++,
-      UXR_DATAREADER_ID);
-    uint16_t datareader_req = UXR_INVALID_REQUEST_ID;
-
-#ifdef RMW_UXRCE_USE_REFS
-    if (!build_datareader_profile(
-        topic_name, rmw_uxrce_entity_naming_buffer,
-        sizeof(rmw_uxrce_entity_naming_buffer)))
+    if (!acquire_xrce_object_id(
+        custom_node->context, UXR_DATAREADER_ID, &custom_subscription->datareader_id))
     {
-      RMW_UROS_TRACE_MESSAGE("failed to generate xml request for node creation")
       goto fail;
     }
+    uint16_t datareader_req = buffer_datareader_creation(custom_subscription);
 
-    datareader_req = uxr_buffer_create_datareader_ref(
-      &custom_node->context->session,
-      *custom_node->context->creation_stream, custom_subscription->datareader_id,
-      custom_subscription->subscriber_id, rmw_uxrce_entity_naming_buffer, UXR_REPLACE | UXR_REUSE);
-#else
-    datareader_req = uxr_buffer_create_datareader_bin(
-      &custom_node->context->session,
-      *custom_node->context->creation_stream,
-      custom_subscription->datareader_id,
-      custom_subscription->subscriber_id,
-      custom_subscription->topic->topic_id,
-      convert_qos_profile(qos_policies),
-      UXR_REPLACE | UXR_REUSE);
-#endif /* ifdef RMW_UXRCE_USE_XML */
-
-    if (!run_xrce_session(
-        custom_node->context, custom_node->context->creation_stream, datareader_req,
-        custom_node->context->creation_timeout))
+    if (!run_xrce_creation(
+        custom_node->context, &custom_subscription->datareader_id, topic_name, datareader_req))
     {
       RMW_UROS_TRACE_MESSAGE("Issues creating Micro XRCE-DDS entities")
       goto fail;
     }
 
-    uxrDeliveryControl delivery_control;
-    delivery_control.max_samples = UXR_MAX_SAMPLES_UNLIMITED;
-    delivery_control.min_pace_period = 0;
-    delivery_control.max_elapsed_time = UXR_MAX_ELAPSED_TIME_UNLIMITED;
-    delivery_control.max_bytes_per_second = UXR_MAX_BYTES_PER_SECOND_UNLIMITED;
-
-    uxrStreamId data_request_stream_id =
-      (qos_policies->reliability == RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT) ?
-      custom_node->context->best_effort_input :
-      custom_node->context->reliable_input;
-
-    uxr_buffer_request_data(
-      &custom_node->context->session,
-      *custom_node->context->creation_stream, custom_subscription->datareader_id,
-      data_request_stream_id, &delivery_control);
+    buffer_subscription_data_request(custom_subscription);
   }
   return rmw_subscription;
 
 fail:
-  if (custom_subscription != NULL && custom_subscription->topic != NULL) {
-    rmw_uxrce_fini_topic_memory(custom_subscription->topic);
+  if (custom_subscription != NULL) {
+    rmw_context_impl_t * context = custom_subscription->owner_node->context;
+    release_xrce_object_id(context, &custom_subscription->datareader_id);
+    release_xrce_object_id(context, &custom_subscription->subscriber_id);
+
+    if (custom_subscription->topic != NULL) {
+      release_xrce_object_id(context, &custom_subscription->topic->topic_id);
+      rmw_uxrce_fini_topic_memory(custom_subscription->topic);
+    }
   }
 
   rmw_uxrce_fini_subscription_memory(rmw_subscription);
@@ -314,37 +435,18 @@ rmw_destroy_subscription(
     rmw_uxrce_subscription_t * custom_subscription = (rmw_uxrce_subscription_t *)subscription->data;
     rmw_uxrce_node_t * custom_node = custom_subscription->owner_node;
 
-    uint16_t datareader_req = uxr_buffer_cancel_data(
-      &custom_node->context->session,
-      *custom_node->context->destroy_stream,
-      custom_subscription->datareader_id);
-
-    run_xrce_session(
-      custom_node->context, custom_node->context->destroy_stream, datareader_req,
-      custom_node->context->destroy_timeout);
-
-    destroy_topic(custom_subscription->topic);
+    const uxrObjectId entities[] = {
+      custom_subscription->datareader_id, custom_subscription->subscriber_id
+    };
 
-    uint16_t delete_datareader =
-      uxr_buffer_delete_entity(
-      &custom_subscription->owner_node->context->session,
-      *custom_subscription->owner_node->context->destroy_stream,
-      custom_subscription->datareader_id);
-    uint16_t delete_subscriber =
-      uxr_buffer_delete_entity(
-      &custom_subscription->owner_node->context->session,
-      *custom_subscription->owner_node->context->destroy_stream,
-      custom_subscription->subscriber_id);
-
-    bool ret = run_xrce_session(
-      custom_node->context, custom_node->context->destroy_stream, delete_datareader,
-      custom_node->context->destroy_timeout);
-    ret &= run_xrce_session(
-      custom_node->context, custom_node->context->destroy_stream, delete_subscriber,
-      custom_node->context->destroy_timeout);
-    if (!ret) {
+    if (!run_xrce_deletion(
+        custom_node->context, true, entities,
+        sizeof(entities) / sizeof(entities[0])))
+    {
       result_ret = RMW_RET_TIMEOUT;
     }
+
+    destroy_topic(custom_subscription->topic);
     rmw_uxrce_fini_subscription_memory(subscription);
   }
 
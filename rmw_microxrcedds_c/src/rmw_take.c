@@ -16,7 +16,10 @@
 #include <rmw/event.h>
 #include <rmw_microxrcedds_c/rmw_c_macros.h>
 
+#include <string.h>
+
 #include "./rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/rmw_event.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
 rmw_ret_t
@@ -38,7 +41,6 @@ rmw_take_with_info(
   rmw_subscription_allocation_t * allocation)
 {
   (void)message_info;
-  (void)allocation;
 
   RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
     subscription->implementation_identifier,
@@ -50,34 +52,71 @@ rmw_take_with_info(
 
   rmw_uxrce_subscription_t * custom_subscription = (rmw_uxrce_subscription_t *)subscription->data;
 
-  rmw_uxrce_clean_expired_static_input_buffer();
-
-  UXR_LOCK(&static_buffer_memory.mutex);
+#if RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+  rmw_uxrce_subscription_allocation_t * subscription_allocation = NULL;
+  if (NULL != allocation) {
+    subscription_allocation = (rmw_uxrce_subscription_allocation_t *)allocation->data;
+
+    if (!is_uxrce_rmw_identifier_valid(allocation->implementation_identifier) ||
+      NULL == subscription_allocation ||
+      subscription_allocation->type_support_callbacks !=
+      custom_subscription->type_support_callbacks)
+    {
+      RMW_UROS_TRACE_MESSAGE("allocation not initialized for this message type")
+      return RMW_RET_INVALID_ARGUMENT;
+    }
+  }
+#else
+  (void)allocation;
+#endif  // RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
 
-  // Find first related item in static buffer memory pool
-  rmw_uxrce_mempool_item_t * static_buffer_item = rmw_uxrce_find_static_input_buffer_by_owner(
-    (void *) custom_subscription);
-  if (static_buffer_item == NULL) {
-    UXR_UNLOCK(&static_buffer_memory.mutex);
+  // Take the oldest sample, it is deserialized out of the queue lock
+  rmw_uxrce_static_input_buffer_t * static_buffer = rmw_uxrce_input_queue_pop(
+    &custom_subscription->input_queue, &custom_subscription->qos);
+  if (static_buffer == NULL) {
     return RMW_RET_ERROR;
   }
 
-  rmw_uxrce_static_input_buffer_t * static_buffer =
-    (rmw_uxrce_static_input_buffer_t *)static_buffer_item->data;
-
+  bool deserialize_rv;
   ucdrBuffer temp_buffer;
-  ucdr_init_buffer(
-    &temp_buffer,
-    static_buffer->buffer,
-    static_buffer->length);
-
-  bool deserialize_rv = custom_subscription->type_support_callbacks->cdr_deserialize(
-    &temp_buffer,
-    ros_message);
 
-  put_memory(&static_buffer_memory, static_buffer_item);
+#if RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+  if (NULL != subscription_allocation &&
+    static_buffer->length > RMW_UXRCE_SUBSCRIPTION_ALLOCATION_SIZE)
+  {
+    // Only intra-process samples may exceed an input stream, when history slots are bigger
+    rmw_uxrce_put_static_input_buffer(static_buffer);
+    RMW_UROS_TRACE_MESSAGE("sample does not fit in the subscription allocation")
+    return RMW_RET_ERROR;
+  }
 
-  UXR_UNLOCK(&static_buffer_memory.mutex);
+  if (NULL != subscription_allocation) {
+    // The sample is moved to the allocation, so its history slot and large buffer are free
+    // for the next sample while it is deserialized
+    UXR_LOCK(&subscription_allocation->mutex);
+    size_t length = static_buffer->length;
+    memcpy(subscription_allocation->buffer, static_buffer->buffer, length);
+    rmw_uxrce_put_static_input_buffer(static_buffer);
+
+    ucdr_init_buffer(&temp_buffer, subscription_allocation->buffer, length);
+    deserialize_rv = custom_subscription->type_support_callbacks->cdr_deserialize(
+      &temp_buffer,
+      ros_message);
+    UXR_UNLOCK(&subscription_allocation->mutex);
+  } else
+#endif  // RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+  {
+    ucdr_init_buffer(
+      &temp_buffer,
+      static_buffer->buffer,
+      static_buffer->length);
+
+    deserialize_rv = custom_subscription->type_support_callbacks->cdr_deserialize(
+      &temp_buffer,
+      ros_message);
+
+    rmw_uxrce_put_static_input_buffer(static_buffer);
+  }
 
   if (taken != NULL) {
     *taken = deserialize_rv;
@@ -217,9 +256,65 @@ rmw_take_event(
   void * event_info,
   bool * taken)
 {
-  (void)event_handle;
-  (void)event_info;
-  (void)taken;
-  RMW_UROS_TRACE_MESSAGE("function not implemented")
-  return RMW_RET_UNSUPPORTED;
+  RMW_CHECK_ARGUMENT_FOR_NULL(event_handle, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(event_info, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    event_handle->implementation_identifier,
+    RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+  *taken = false;
+
+  // Brings the deadline status up to date
+  rmw_uxrce_event_is_ready(event_handle, NULL);
+
+  switch (event_handle->event_type) {
+    case RMW_EVENT_MESSAGE_LOST:
+      {
+        rmw_uxrce_subscription_t * custom_subscription =
+          (rmw_uxrce_subscription_t *)event_handle->data;
+        rmw_message_lost_status_t * status = (rmw_message_lost_status_t *)event_info;
+
+        UXR_LOCK(&custom_subscription->input_queue.mutex);
+        status->total_count = custom_subscription->message_lost.total_count;
+        status->total_count_change = custom_subscription->message_lost.total_count_change;
+        custom_subscription->message_lost.total_count_change = 0;
+        UXR_UNLOCK(&custom_subscription->input_queue.mutex);
+        break;
+      }
+    case RMW_EVENT_REQUESTED_DEADLINE_MISSED:
+      {
+        rmw_uxrce_subscription_t * custom_subscription =
+          (rmw_uxrce_subscription_t *)event_handle->data;
+        rmw_requested_deadline_missed_status_t * status =
+          (rmw_requested_deadline_missed_status_t *)event_info;
+
+        UXR_LOCK(&custom_subscription->input_queue.mutex);
+        status->total_count = (int32_t)custom_subscription->deadline_missed.total_count;
+        status->total_count_change =
+          (int32_t)custom_subscription->deadline_missed.total_count_change;
+        custom_subscription->deadline_missed.total_count_change = 0;
+        UXR_UNLOCK(&custom_subscription->input_queue.mutex);
+        break;
+      }
+    case RMW_EVENT_OFFERED_DEADLINE_MISSED:
+      {
+        rmw_uxrce_publisher_t * custom_publisher = (rmw_uxrce_publisher_t *)event_handle->data;
+        rmw_offered_deadline_missed_status_t * status =
+          (rmw_offered_deadline_missed_status_t *)event_info;
+
+        UXR_LOCK(&custom_publisher->mutex);
+        status->total_count = (int32_t)custom_publisher->deadline_missed.total_count;
+        status->total_count_change = (int32_t)custom_publisher->deadline_missed.total_count_change;
+        custom_publisher->deadline_missed.total_count_change = 0;
+        UXR_UNLOCK(&custom_publisher->mutex);
+        break;
+      }
+    default:
+      RMW_UROS_TRACE_MESSAGE("event type not supported")
+      return RMW_RET_UNSUPPORTED;
+  }
+
+  *taken = true;
+  return RMW_RET_OK;
 }
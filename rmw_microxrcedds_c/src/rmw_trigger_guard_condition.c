@@ -16,6 +16,7 @@
 #include <rmw/names_and_types.h>
 
 #include "./rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/wakeup.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
 rmw_ret_t
@@ -33,6 +34,9 @@ rmw_trigger_guard_condition(
     rmw_uxrce_guard_condition_t * aux_guard_condition =
       (rmw_uxrce_guard_condition_t *)guard_condition->data;
     aux_guard_condition->hasTriggered = true;
+
+    // Interrupt any rmw_wait blocked on the transports
+    rmw_uxrce_wakeup_signal();
   }
 
   return ret;
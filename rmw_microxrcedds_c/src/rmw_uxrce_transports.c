@@ -138,3 +138,11 @@ rmw_ret_t rmw_uxrce_transport_init(
 #endif /* ifdef RMW_UXRCE_TRANSPORT_SERIAL */
   return RMW_RET_OK;
 }
+
+#if defined(UCLIENT_PLATFORM_POSIX) && !defined(RMW_UXRCE_TRANSPORT_CUSTOM)
+int rmw_uxrce_transport_fd(
+  const rmw_context_impl_t * context)
+{
+  return context->transport.platform.poll_fd.fd;
+}
+#endif  // if defined(UCLIENT_PLATFORM_POSIX) && !defined(RMW_UXRCE_TRANSPORT_CUSTOM)
@@ -12,114 +12,590 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+// Required for ppoll()
+#define _GNU_SOURCE
+#endif  // if defined(__linux__) && !defined(_GNU_SOURCE)
+
 #include <limits.h>
 #include <math.h>
+#include <stdint.h>
 
 #include <rmw/rmw.h>
 #include <rmw/time.h>
 #include <uxr/client/core/session/session.h>
+#include <uxr/client/util/time.h>
 
 #include "./rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/wakeup.h"
+#include "./rmw_microros_internal/io_thread.h"
+#include "./rmw_microros_internal/rmw_event.h"
+#include "./rmw_microros_internal/rmw_publisher.h"
+#include "./rmw_microros_internal/rmw_uxrce_transports.h"
+#include "./rmw_microros_internal/error_handling_internal.h"
 
-rmw_ret_t
-rmw_wait(
+#ifdef UCLIENT_PLATFORM_POSIX
+#include <time.h>
+#endif  // UCLIENT_PLATFORM_POSIX
+
+#ifdef RMW_UXRCE_WAIT_POLL
+#include <errno.h>
+#include <poll.h>
+#endif  // RMW_UXRCE_WAIT_POLL
+
+#define RMW_UXRCE_WAIT_INFINITE -1
+
+// Drops the expired samples of the waited entities, so they do not report readiness
+static void
+rmw_uxrce_wait_clean_expired(
+  rmw_subscriptions_t * subscriptions,
+  rmw_services_t * services,
+  rmw_clients_t * clients)
+{
+  for (size_t i = 0; services && i < services->service_count; ++i) {
+    rmw_uxrce_service_t * custom_service = (rmw_uxrce_service_t *)services->services[i];
+    rmw_uxrce_input_queue_clean_expired(&custom_service->input_queue, &custom_service->qos);
+  }
+
+  for (size_t i = 0; clients && i < clients->client_count; ++i) {
+    rmw_uxrce_client_t * custom_client = (rmw_uxrce_client_t *)clients->clients[i];
+    rmw_uxrce_input_queue_clean_expired(&custom_client->input_queue, &custom_client->qos);
+  }
+
+  for (size_t i = 0; subscriptions && i < subscriptions->subscriber_count; ++i) {
+    rmw_uxrce_subscription_t * custom_subscription =
+      (rmw_uxrce_subscription_t *)subscriptions->subscribers[i];
+    rmw_uxrce_input_queue_clean_expired(
+      &custom_subscription->input_queue, &custom_subscription->qos);
+  }
+}
+
+// Shortens the timeout so that the wait returns when the next deadline expires
+static void
+rmw_uxrce_wait_events_timeout(
+  rmw_events_t * events,
+  int64_t * timeout_ns)
+{
+  for (size_t i = 0; events && i < events->event_count; ++i) {
+    int64_t next_expiration = -1;
+    rmw_uxrce_event_is_ready((rmw_event_t *)events->events[i], &next_expiration);
+
+    if (0 <= next_expiration &&
+      (RMW_UXRCE_WAIT_INFINITE == *timeout_ns || next_expiration < *timeout_ns))
+    {
+      *timeout_ns = next_expiration;
+    }
+  }
+}
+
+static bool
+rmw_uxrce_wait_has_pending(
   rmw_subscriptions_t * subscriptions,
   rmw_guard_conditions_t * guard_conditions,
   rmw_services_t * services,
   rmw_clients_t * clients,
-  rmw_events_t * events,
-  rmw_wait_set_t * wait_set,
-  const rmw_time_t * wait_timeout)
+  rmw_events_t * events)
 {
-  (void)events;
-  (void)wait_set;
+  for (size_t i = 0; events && i < events->event_count; ++i) {
+    if (rmw_uxrce_event_is_ready((rmw_event_t *)events->events[i], NULL)) {
+      return true;
+    }
+  }
 
-  // With `rmw_uxrce_wait_mutex` member `need_to_be_ran` is protected.
-  // `session_memory` itself is not protected because it is not modified between
-  // rmw_init and rmw_shutdown, and rmw_wait cannot be called concurrently with
-  // those functions.
-  UXR_LOCK(&rmw_uxrce_wait_mutex);
+  for (size_t i = 0; guard_conditions && i < guard_conditions->guard_condition_count; ++i) {
+    rmw_uxrce_guard_condition_t * custom_guard_condition =
+      (rmw_uxrce_guard_condition_t *)guard_conditions->guard_conditions[i];
+    if (custom_guard_condition->hasTriggered) {
+      return true;
+    }
+  }
 
-  if (!services && !clients && !subscriptions && !guard_conditions) {
-    UXR_UNLOCK(&rmw_uxrce_wait_mutex);
-    return RMW_RET_OK;
+  for (size_t i = 0; services && i < services->service_count; ++i) {
+    if (((rmw_uxrce_service_t *)services->services[i])->input_queue.count > 0) {
+      return true;
+    }
   }
 
-  // Check if timeout
-  union {
-    int64_t i64;
-    int32_t i32;
-  } timeout;
+  for (size_t i = 0; clients && i < clients->client_count; ++i) {
+    if (((rmw_uxrce_client_t *)clients->clients[i])->input_queue.count > 0) {
+      return true;
+    }
+  }
 
-  if (NULL == wait_timeout || rmw_time_equal(*wait_timeout, (rmw_time_t)RMW_DURATION_INFINITE)) {
-    timeout.i32 = UXR_TIMEOUT_INF;
-  } else {
-    timeout.i64 = rmw_time_total_nsec(*wait_timeout) / 1000000ULL;
-    timeout.i32 = (timeout.i64 > INT32_MAX) ? INT32_MAX : timeout.i64;
+  for (size_t i = 0; subscriptions && i < subscriptions->subscriber_count; ++i) {
+    if (((rmw_uxrce_subscription_t *)subscriptions->subscribers[i])->input_queue.count > 0) {
+      return true;
+    }
   }
 
-  rmw_uxrce_clean_expired_static_input_buffer();
+  return false;
+}
+
+static void
+rmw_uxrce_wait_set_add_session(
+  rmw_uxrce_wait_set_t * custom_wait_set,
+  rmw_uxrce_session_t * session)
+{
+  // Sessions are kept sorted by address so that their locks are always taken in the same order
+  size_t position = 0;
+  while (position < custom_wait_set->session_count &&
+    (uintptr_t)custom_wait_set->sessions[position] < (uintptr_t)session)
+  {
+    position++;
+  }
 
-  // Clear run flag for all sessions
-  rmw_uxrce_mempool_item_t * item = session_memory.allocateditems;
-  while (item != NULL) {
-    rmw_context_impl_t * custom_context = (rmw_context_impl_t *)item->data;
-    custom_context->need_to_be_ran = false;
-    item = item->next;
+  if (position < custom_wait_set->session_count &&
+    custom_wait_set->sessions[position] == session)
+  {
+    return;
   }
 
-  // TODO(pablogs9): What happens if there already data in one entity?
-  // Enable flag for every XRCE session available in the entities
+  if (custom_wait_set->session_count >= RMW_UXRCE_MAX_SESSIONS) {
+    RMW_UROS_TRACE_MESSAGE("Wait set session cache is full")
+    return;
+  }
+
+  for (size_t i = custom_wait_set->session_count; i > position; i--) {
+    custom_wait_set->sessions[i] = custom_wait_set->sessions[i - 1];
+  }
+
+  custom_wait_set->sessions[position] = session;
+  custom_wait_set->session_count++;
+  custom_wait_set->session_cached[session - custom_sessions] = true;
+}
+
+// Marks the session of an attached entity as used, failing if it is not cached
+static bool
+rmw_uxrce_wait_set_use_session(
+  rmw_uxrce_wait_set_t * custom_wait_set,
+  rmw_uxrce_session_t * session,
+  bool * used,
+  size_t * used_count)
+{
+  size_t index = (size_t)(session - custom_sessions);
+
+  if (!custom_wait_set->session_cached[index]) {
+    return false;
+  }
+
+  if (!used[index]) {
+    used[index] = true;
+    (*used_count)++;
+  }
+
+  return true;
+}
+
+// Checks that the cached sessions are exactly the ones owning the attached entities
+static bool
+rmw_uxrce_wait_set_sessions_match(
+  rmw_uxrce_wait_set_t * custom_wait_set,
+  rmw_subscriptions_t * subscriptions,
+  rmw_services_t * services,
+  rmw_clients_t * clients)
+{
+  bool used[RMW_UXRCE_MAX_SESSIONS] = {false};
+  size_t used_count = 0;
+
   for (size_t i = 0; services && i < services->service_count; ++i) {
     rmw_uxrce_service_t * custom_service = (rmw_uxrce_service_t *)services->services[i];
-    custom_service->owner_node->context->need_to_be_ran = true;
+    if (!rmw_uxrce_wait_set_use_session(
+        custom_wait_set, custom_service->owner_node->context, used, &used_count))
+    {
+      return false;
+    }
   }
 
   for (size_t i = 0; clients && i < clients->client_count; ++i) {
     rmw_uxrce_client_t * custom_client = (rmw_uxrce_client_t *)clients->clients[i];
-    custom_client->owner_node->context->need_to_be_ran = true;
+    if (!rmw_uxrce_wait_set_use_session(
+        custom_wait_set, custom_client->owner_node->context, used, &used_count))
+    {
+      return false;
+    }
   }
 
   for (size_t i = 0; subscriptions && i < subscriptions->subscriber_count; ++i) {
     rmw_uxrce_subscription_t * custom_subscription =
       (rmw_uxrce_subscription_t *)subscriptions->subscribers[i];
-    custom_subscription->owner_node->context->need_to_be_ran = true;
+    if (!rmw_uxrce_wait_set_use_session(
+        custom_wait_set, custom_subscription->owner_node->context, used, &used_count))
+    {
+      return false;
+    }
   }
 
-  // Count sessions to be ran
-  uint8_t available_contexts = 0;
-  item = session_memory.allocateditems;
-  while (item != NULL) {
-    rmw_context_impl_t * custom_context = (rmw_context_impl_t *)item->data;
-    available_contexts += custom_context->need_to_be_ran ? 1 : 0;
-    item = item->next;
+  return used_count == custom_wait_set->session_count;
+}
+
+// Rebuilds the sessions of a wait set only when they do not match its entities
+// or the wait set has been invalidated by the destruction of an entity
+static void
+rmw_uxrce_wait_set_update_sessions(
+  rmw_uxrce_wait_set_t * custom_wait_set,
+  rmw_subscriptions_t * subscriptions,
+  rmw_services_t * services,
+  rmw_clients_t * clients)
+{
+  UXR_LOCK(&wait_set_memory.mutex);
+
+  if (custom_wait_set->sessions_valid &&
+    rmw_uxrce_wait_set_sessions_match(custom_wait_set, subscriptions, services, clients))
+  {
+    UXR_UNLOCK(&wait_set_memory.mutex);
+    return;
   }
 
-  // There is no context that contais any of the wait set entities. Nothing to wait here.
-  if (available_contexts != 0) {
-    int32_t per_session_timeout =
-      (timeout.i32 == UXR_TIMEOUT_INF) ? UXR_TIMEOUT_INF :
-      (int32_t)((float)timeout.i32 / (float)available_contexts);
+  custom_wait_set->session_count = 0;
+  for (size_t i = 0; i < RMW_UXRCE_MAX_SESSIONS; i++) {
+    custom_wait_set->session_cached[i] = false;
+  }
 
-    item = session_memory.allocateditems;
-    while (item != NULL) {
-      rmw_context_impl_t * custom_context = (rmw_context_impl_t *)item->data;
-      if (custom_context->need_to_be_ran) {
-        uxr_run_session_until_data(&custom_context->session, per_session_timeout);
+  for (size_t i = 0; services && i < services->service_count; ++i) {
+    rmw_uxrce_service_t * custom_service = (rmw_uxrce_service_t *)services->services[i];
+    rmw_uxrce_wait_set_add_session(custom_wait_set, custom_service->owner_node->context);
+  }
+
+  for (size_t i = 0; clients && i < clients->client_count; ++i) {
+    rmw_uxrce_client_t * custom_client = (rmw_uxrce_client_t *)clients->clients[i];
+    rmw_uxrce_wait_set_add_session(custom_wait_set, custom_client->owner_node->context);
+  }
+
+  for (size_t i = 0; subscriptions && i < subscriptions->subscriber_count; ++i) {
+    rmw_uxrce_subscription_t * custom_subscription =
+      (rmw_uxrce_subscription_t *)subscriptions->subscribers[i];
+    rmw_uxrce_wait_set_add_session(custom_wait_set, custom_subscription->owner_node->context);
+  }
+
+  custom_wait_set->sessions_valid = true;
+
+  UXR_UNLOCK(&wait_set_memory.mutex);
+}
+
+#ifndef RMW_UXRCE_IO_THREAD
+// Time base of the wait deadlines, it must not jump with the wall clock
+static int64_t
+rmw_uxrce_wait_now(void)
+{
+#ifdef UCLIENT_PLATFORM_POSIX
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000LL + (int64_t)ts.tv_nsec;
+#else
+  return uxr_nanos();
+#endif  // UCLIENT_PLATFORM_POSIX
+}
+
+// Truncates a timeout to milliseconds. The session API cannot wait for less than that,
+// so the caller spins again until its deadline instead of waiting past it.
+static int32_t
+rmw_uxrce_wait_timeout_ms(
+  int64_t timeout_ns)
+{
+  if (RMW_UXRCE_WAIT_INFINITE == timeout_ns) {
+    return UXR_TIMEOUT_INF;
+  }
+
+  int64_t timeout_ms = timeout_ns / 1000000LL;
+  return (timeout_ms > INT32_MAX) ? INT32_MAX : (int32_t)timeout_ms;
+}
+
+#ifdef RMW_UXRCE_WAIT_POLL
+// Serves the wait set sessions without blocking for as long as they receive data.
+// The framing of stream transports may already hold complete frames that left
+// nothing to read on the file descriptor, so its readiness is not enough.
+static bool
+rmw_uxrce_wait_drain_sessions(
+  rmw_uxrce_wait_set_t * custom_wait_set)
+{
+  bool data_received = false;
+
+  for (size_t i = 0; i < custom_wait_set->session_count; i++) {
+    while (uxr_run_session_until_data(&custom_wait_set->sessions[i]->session, 0)) {
+      data_received = true;
+    }
+  }
+
+  return data_received;
+}
+#endif  // RMW_UXRCE_WAIT_POLL
+
+// Waits until any of the wait set sessions receives data, the timeout expires
+// or one of the entities becomes ready without the Agent, as guard conditions
+// and intra-process samples do. Returns false if a session transport has failed.
+static bool
+rmw_uxrce_wait_sessions(
+  rmw_uxrce_wait_set_t * custom_wait_set,
+  rmw_subscriptions_t * subscriptions,
+  rmw_guard_conditions_t * guard_conditions,
+  rmw_services_t * services,
+  rmw_clients_t * clients,
+  int64_t timeout_ns)
+{
+  size_t session_count = custom_wait_set->session_count;
+
+#ifdef RMW_UXRCE_WAIT_POLL
+  if (0 != timeout_ns) {
+    // Wait on all the session transports at once instead of slicing the timeout
+    struct pollfd fds[RMW_UXRCE_MAX_SESSIONS + 1];
+    nfds_t nfds = 0;
+
+    for (size_t i = 0; i < session_count; i++) {
+      fds[nfds].fd = rmw_uxrce_transport_fd(custom_wait_set->sessions[i]);
+      fds[nfds].events = POLLIN;
+      nfds++;
+    }
+
+    int wakeup_fd = rmw_uxrce_wakeup_fd(custom_wait_set);
+    if (0 <= wakeup_fd) {
+      fds[nfds].fd = wakeup_fd;
+      fds[nfds].events = POLLIN;
+      nfds++;
+    }
+
+    // The period only bounds each poll call, the timeout is always measured from the deadline
+    const int64_t poll_period_ns = RMW_UXRCE_WAIT_POLL_PERIOD * 1000000LL;
+    int64_t deadline = rmw_uxrce_wait_now() + timeout_ns;
+    int64_t remaining = timeout_ns;
+
+    for (;;) {
+      // Serve every session even on timeout to keep reliable streams alive
+      if (rmw_uxrce_wait_drain_sessions(custom_wait_set)) {
+        return true;
+      }
+
+      if (rmw_uxrce_wait_has_pending(subscriptions, guard_conditions, services, clients, NULL)) {
+        return true;
+      }
+
+      if (RMW_UXRCE_WAIT_INFINITE != timeout_ns) {
+        remaining = deadline - rmw_uxrce_wait_now();
+        if (remaining <= 0) {
+          return true;
+        }
+      }
+
+      int64_t poll_timeout_ns =
+        (RMW_UXRCE_WAIT_INFINITE == timeout_ns || remaining > poll_period_ns) ?
+        poll_period_ns : remaining;
+
+      for (nfds_t i = 0; i < nfds; i++) {
+        fds[i].revents = 0;
+      }
+
+#if defined(__linux__)
+      // Keep the requested resolution, poll() would round it to milliseconds
+      struct timespec poll_timeout;
+      poll_timeout.tv_sec = (time_t)(poll_timeout_ns / 1000000000LL);
+      poll_timeout.tv_nsec = (long)(poll_timeout_ns % 1000000000LL);
+      int poll_ret = ppoll(fds, nfds, &poll_timeout, NULL);
+#else
+      // Rounded up, a shorter poll would be retried until the deadline anyway
+      int poll_ret = poll(fds, nfds, rmw_uxrce_wait_timeout_ms(poll_timeout_ns + 999999LL));
+#endif  // defined(__linux__)
+
+      if (0 > poll_ret && EINTR != errno) {
+        return true;
+      }
+
+      // A closed or failed transport stays readable, waiting on it again would never block
+      for (size_t i = 0; 0 < poll_ret && i < session_count; i++) {
+        if (fds[i].revents & RMW_UXRCE_TRANSPORT_POLL_ERROR) {
+          RMW_UROS_TRACE_MESSAGE("Session transport closed or failed")
+          return false;
+        }
+      }
+
+      // Signals are shared by all the wait sets and may be left over from an
+      // already served trigger, so only the own entities end the wait
+      if (0 <= wakeup_fd && (fds[nfds - 1].revents & POLLIN)) {
+        rmw_uxrce_wakeup_drain(custom_wait_set);
       }
-      item = item->next;
+    }
+  }
+#endif  // RMW_UXRCE_WAIT_POLL
+
+  // The remaining time is recomputed from the deadline and sliced again before each session,
+  // so the time left unused by a session is given to the next ones. Slices are truncated to
+  // milliseconds, the sessions are spun again until the deadline to wait the rest.
+  // Without a custom transport wakeup callback a session read cannot be interrupted, so
+  // slices last at most a period and entities ready without the Agent are checked in between.
+  const int64_t slice_period_ns = RMW_UXRCE_WAIT_POLL_PERIOD * 1000000LL;
+  int64_t deadline = (RMW_UXRCE_WAIT_INFINITE == timeout_ns) ?
+    0 : rmw_uxrce_wait_now() + timeout_ns;
+  bool data_received = false;
+
+  for (;;) {
+    for (size_t i = 0; i < session_count; i++) {
+      int64_t slice_ns = slice_period_ns;
+
+      if (data_received) {
+        // Only fetch what the remaining sessions have already received
+        slice_ns = 0;
+      } else if (RMW_UXRCE_WAIT_INFINITE != timeout_ns) {
+        int64_t remaining = deadline - rmw_uxrce_wait_now();
+        slice_ns = (remaining > 0) ? remaining / (int64_t)(session_count - i) : 0;
+        slice_ns = (slice_ns > slice_period_ns) ? slice_period_ns : slice_ns;
+      }
+
+      data_received |= uxr_run_session_until_data(
+        &custom_wait_set->sessions[i]->session, rmw_uxrce_wait_timeout_ms(slice_ns));
+
+      if (!data_received &&
+        rmw_uxrce_wait_has_pending(subscriptions, guard_conditions, services, clients, NULL))
+      {
+        return true;
+      }
+    }
+
+    if (data_received ||
+      (RMW_UXRCE_WAIT_INFINITE != timeout_ns && rmw_uxrce_wait_now() >= deadline))
+    {
+      return true;
+    }
+  }
+}
+
+#else
+static void
+rmw_uxrce_wait_io_threads(
+  rmw_uxrce_wait_set_t * custom_wait_set,
+  bool notified,
+  rmw_subscriptions_t * subscriptions,
+  rmw_guard_conditions_t * guard_conditions,
+  rmw_services_t * services,
+  rmw_clients_t * clients,
+  rmw_events_t * events,
+  int64_t timeout_ns)
+{
+  int64_t deadline = (RMW_UXRCE_WAIT_INFINITE == timeout_ns) ?
+    -1 : rmw_uxrce_io_thread_now() + timeout_ns;
+
+  for (;;) {
+    // Taking the sequence before checking avoids losing a notification in between
+    uint32_t sequence = rmw_uxrce_io_thread_sequence(custom_wait_set);
+
+    if (0 == timeout_ns ||
+      rmw_uxrce_wait_has_pending(subscriptions, guard_conditions, services, clients, events))
+    {
+      return;
+    }
+
+    // Wait sets that are not created by this RMW are never notified, check them periodically
+    int64_t wait_deadline = deadline;
+    if (!notified) {
+      int64_t period_deadline = rmw_uxrce_io_thread_now() +
+        RMW_UXRCE_IO_THREAD_PERIOD * 1000000LL;
+      if (0 > deadline || period_deadline < deadline) {
+        wait_deadline = period_deadline;
+      }
+    }
+
+    if (!rmw_uxrce_io_thread_wait(custom_wait_set, sequence, wait_deadline) &&
+      wait_deadline == deadline)
+    {
+      return;
+    }
+  }
+}
+#endif  // RMW_UXRCE_IO_THREAD
+
+rmw_ret_t
+rmw_wait(
+  rmw_subscriptions_t * subscriptions,
+  rmw_guard_conditions_t * guard_conditions,
+  rmw_services_t * services,
+  rmw_clients_t * clients,
+  rmw_events_t * events,
+  rmw_wait_set_t * wait_set,
+  const rmw_time_t * wait_timeout)
+{
+  if (!services && !clients && !subscriptions && !guard_conditions && !events) {
+    return RMW_RET_OK;
+  }
+
+  // Check if timeout, kept in nanoseconds down to the transport wait
+  int64_t timeout_ns = RMW_UXRCE_WAIT_INFINITE;
+
+  if (NULL != wait_timeout &&
+    !rmw_time_equal(*wait_timeout, (rmw_time_t)RMW_DURATION_INFINITE))
+  {
+    timeout_ns = rmw_time_total_nsec(*wait_timeout);
+    timeout_ns = (timeout_ns < 0) ? 0 : timeout_ns;
+  }
+
+  rmw_uxrce_flush_publisher_allocations();
+  rmw_uxrce_wait_clean_expired(subscriptions, services, clients);
+  rmw_uxrce_wait_events_timeout(events, &timeout_ns);
+
+  // Wait sets created by this RMW keep the sessions of their entities between calls
+  rmw_uxrce_wait_set_t local_wait_set;
+  rmw_uxrce_wait_set_t * custom_wait_set = &local_wait_set;
+  if (NULL != wait_set && NULL != wait_set->data) {
+    custom_wait_set = (rmw_uxrce_wait_set_t *)wait_set->data;
+  } else {
+    local_wait_set.sessions_valid = false;
+    local_wait_set.wakeup_pipe[0] = -1;
+    local_wait_set.wakeup_pipe[1] = -1;
+  }
+
+  rmw_uxrce_wait_set_update_sessions(custom_wait_set, subscriptions, services, clients);
+
+#ifdef RMW_UXRCE_IO_THREAD
+  // Sessions are spun by their I/O threads, several rmw_wait calls can block concurrently
+  // and each one is only notified by the I/O threads of its own sessions
+  bool notified = custom_wait_set != &local_wait_set;
+  if (!notified) {
+    rmw_uxrce_io_thread_init_wait_set(&local_wait_set);
+  }
+
+  rmw_uxrce_wait_io_threads(
+    custom_wait_set, notified, subscriptions, guard_conditions, services, clients, events,
+    timeout_ns);
+
+  if (!notified) {
+    rmw_uxrce_io_thread_fini_wait_set(&local_wait_set);
+  }
+#else
+  // If some entity is already ready, only spin the sessions without blocking
+  // to fetch any other incoming data
+  if (rmw_uxrce_wait_has_pending(subscriptions, guard_conditions, services, clients, events)) {
+    timeout_ns = 0;
+  }
+
+  // Each session `wait_mutex` serializes its spinning, so waits on independent
+  // sessions run in parallel. `session_memory` itself is not protected because it
+  // is not modified between rmw_init and rmw_shutdown, and rmw_wait cannot be
+  // called concurrently with those functions.
+
+  // There is no context that contais any of the wait set entities. Nothing to wait here.
+  if (custom_wait_set->session_count != 0) {
+    for (size_t i = 0; i < custom_wait_set->session_count; i++) {
+      UXR_LOCK(&custom_wait_set->sessions[i]->wait_mutex);
+    }
+
+    bool transport_ok = rmw_uxrce_wait_sessions(
+      custom_wait_set, subscriptions, guard_conditions, services, clients, timeout_ns);
+
+    for (size_t i = custom_wait_set->session_count; i > 0; i--) {
+      UXR_UNLOCK(&custom_wait_set->sessions[i - 1]->wait_mutex);
+    }
+
+    if (!transport_ok) {
+      return RMW_RET_ERROR;
     }
   } else {
     // Spin with no blocking to handle session metatraffic
-    item = session_memory.allocateditems;
+    rmw_uxrce_mempool_item_t * item = session_memory.allocateditems;
     while (item != NULL) {
       rmw_context_impl_t * custom_context = (rmw_context_impl_t *)item->data;
+      UXR_LOCK(&custom_context->wait_mutex);
       uxr_run_session_timeout(&custom_context->session, 0);
+      UXR_UNLOCK(&custom_context->wait_mutex);
       item = item->next;
     }
   }
-
-  UXR_UNLOCK(&rmw_uxrce_wait_mutex);
+#endif  // RMW_UXRCE_IO_THREAD
 
   bool buffered_status = false;
 
@@ -127,7 +603,7 @@ rmw_wait(
   for (size_t i = 0; services && i < services->service_count; ++i) {
     rmw_uxrce_service_t * custom_service = (rmw_uxrce_service_t *)services->services[i];
 
-    if (NULL == rmw_uxrce_find_static_input_buffer_by_owner((void *) custom_service)) {
+    if (0 == custom_service->input_queue.count) {
       services->services[i] = NULL;
     } else {
       buffered_status = true;
@@ -138,7 +614,7 @@ rmw_wait(
   for (size_t i = 0; clients && i < clients->client_count; ++i) {
     rmw_uxrce_client_t * custom_client = (rmw_uxrce_client_t *)clients->clients[i];
 
-    if (NULL == rmw_uxrce_find_static_input_buffer_by_owner((void *) custom_client)) {
+    if (0 == custom_client->input_queue.count) {
       clients->clients[i] = NULL;
     } else {
       buffered_status = true;
@@ -150,7 +626,7 @@ rmw_wait(
     rmw_uxrce_subscription_t * custom_subscription =
       (rmw_uxrce_subscription_t *)subscriptions->subscribers[i];
 
-    if (NULL == rmw_uxrce_find_static_input_buffer_by_owner((void *) custom_subscription)) {
+    if (0 == custom_subscription->input_queue.count) {
       subscriptions->subscribers[i] = NULL;
     } else {
       buffered_status = true;
@@ -169,5 +645,14 @@ rmw_wait(
     }
   }
 
+  // Check events
+  for (size_t i = 0; events && i < events->event_count; ++i) {
+    if (!rmw_uxrce_event_is_ready((rmw_event_t *)events->events[i], NULL)) {
+      events->events[i] = NULL;
+    } else {
+      buffered_status = true;
+    }
+  }
+
   return (buffered_status) ? RMW_RET_OK : RMW_RET_TIMEOUT;
 }
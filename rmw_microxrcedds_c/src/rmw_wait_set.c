@@ -16,6 +16,8 @@
 #include <rmw/allocators.h>
 
 #include "./rmw_microros_internal/utils.h"
+#include "./rmw_microros_internal/wakeup.h"
+#include "./rmw_microros_internal/io_thread.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
 rmw_wait_set_t *
@@ -26,13 +28,36 @@ rmw_create_wait_set(
   (void)context;
   (void)max_conditions;
 
+  // Wakeup signals walk the allocated wait sets, keep them from seeing an uninitialized one
+  UXR_LOCK(&wait_set_memory.mutex);
+
   rmw_uxrce_mempool_item_t * memory_node = get_memory(&wait_set_memory);
   if (!memory_node) {
+    UXR_UNLOCK(&wait_set_memory.mutex);
     RMW_UROS_TRACE_MESSAGE("Not available memory node")
     return NULL;
   }
   rmw_uxrce_wait_set_t * aux_wait_set = (rmw_uxrce_wait_set_t *)memory_node->data;
 
+  aux_wait_set->sessions_valid = false;
+  aux_wait_set->session_count = 0;
+  for (size_t i = 0; i < RMW_UXRCE_MAX_SESSIONS; i++) {
+    aux_wait_set->session_cached[i] = false;
+  }
+  aux_wait_set->wakeup_pipe[0] = -1;
+  aux_wait_set->wakeup_pipe[1] = -1;
+#ifdef RMW_UXRCE_IO_THREAD
+  rmw_uxrce_io_thread_init_wait_set(aux_wait_set);
+#endif  // RMW_UXRCE_IO_THREAD
+
+  UXR_UNLOCK(&wait_set_memory.mutex);
+
+  // Without the wakeup channel rmw_wait just cannot be interrupted by guard conditions
+  rmw_uxrce_wakeup_init(aux_wait_set);
+
+  aux_wait_set->rmw_wait_set.implementation_identifier = rmw_get_implementation_identifier();
+  aux_wait_set->rmw_wait_set.data = aux_wait_set;
+
   return &aux_wait_set->rmw_wait_set;
 }
 
@@ -45,7 +70,13 @@ rmw_destroy_wait_set(
   while (NULL != item) {
     rmw_uxrce_wait_set_t * aux_wait_set = (rmw_uxrce_wait_set_t *)item->data;
     if (&aux_wait_set->rmw_wait_set == wait_set) {
+      rmw_uxrce_wakeup_fini(aux_wait_set);
+      UXR_LOCK(&wait_set_memory.mutex);
+#ifdef RMW_UXRCE_IO_THREAD
+      rmw_uxrce_io_thread_fini_wait_set(aux_wait_set);
+#endif  // RMW_UXRCE_IO_THREAD
       put_memory(&wait_set_memory, item);
+      UXR_UNLOCK(&wait_set_memory.mutex);
       return RMW_RET_OK;
     }
     item = item->next;
@@ -31,8 +31,6 @@
 
 // Static memory pools
 
-char rmw_uxrce_entity_naming_buffer[RMW_UXRCE_ENTITY_NAMING_BUFFER_LENGTH];
-
 rmw_uxrce_mempool_t session_memory;
 rmw_context_impl_t custom_sessions[RMW_UXRCE_MAX_SESSIONS];
 
@@ -45,6 +43,12 @@ rmw_uxrce_publisher_t custom_publishers[RMW_UXRCE_MAX_PUBLISHERS];
 rmw_uxrce_mempool_t subscription_memory;
 rmw_uxrce_subscription_t custom_subscriptions[RMW_UXRCE_MAX_SUBSCRIPTIONS];
 
+#if RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+rmw_uxrce_mempool_t subscription_allocation_memory;
+rmw_uxrce_subscription_allocation_t
+  custom_subscription_allocations[RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS];
+#endif  // RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+
 rmw_uxrce_mempool_t service_memory;
 rmw_uxrce_service_t custom_services[RMW_UXRCE_MAX_SERVICES];
 
@@ -57,6 +61,16 @@ rmw_uxrce_topic_t custom_topics[RMW_UXRCE_MAX_TOPICS_INTERNAL];
 rmw_uxrce_mempool_t static_buffer_memory;
 rmw_uxrce_static_input_buffer_t custom_static_buffers[RMW_UXRCE_MAX_HISTORY];
 
+#if RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+rmw_uxrce_mempool_t large_input_buffer_memory;
+rmw_uxrce_large_input_buffer_t custom_large_input_buffers[RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS];
+#endif  // RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+
+#if RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+rmw_uxrce_mempool_t publisher_allocation_memory;
+rmw_uxrce_publisher_allocation_t custom_publisher_allocations[RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS];
+#endif  // RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+
 rmw_uxrce_mempool_t init_options_memory;
 rmw_uxrce_init_options_impl_t custom_init_options[RMW_UXRCE_MAX_OPTIONS];
 
@@ -68,8 +82,10 @@ rmw_uxrce_guard_condition_t custom_guard_condition[RMW_UXRCE_MAX_GUARD_CONDITION
 
 // Global mutexs
 #ifdef UCLIENT_PROFILE_MULTITHREAD
-uxrMutex rmw_uxrce_wait_mutex;
-bool rmw_uxrce_wait_mutex_initialized = false;
+uxrMutex rmw_uxrce_name_cache_mutex;
+bool rmw_uxrce_name_cache_mutex_initialized = false;
+uxrMutex rmw_uxrce_wakeup_callback_mutex;
+bool rmw_uxrce_wakeup_callback_mutex_initialized = false;
 #endif  // UCLIENT_PROFILE_MULTITHREAD
 
 // Memory init functions
@@ -101,10 +117,19 @@ RMW_INIT_MEMORY(service)
 RMW_INIT_MEMORY(client)
 RMW_INIT_MEMORY(publisher)
 RMW_INIT_MEMORY(subscription)
+#if RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
+RMW_INIT_MEMORY(subscription_allocation)
+#endif  // RMW_UXRCE_MAX_SUBSCRIPTION_ALLOCATIONS > 0
 RMW_INIT_MEMORY(node)
 RMW_INIT_MEMORY(session)
 RMW_INIT_MEMORY(topic)
 RMW_INIT_MEMORY(static_input_buffer)
+#if RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+RMW_INIT_MEMORY(large_input_buffer)
+#endif  // RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+#if RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+RMW_INIT_MEMORY(publisher_allocation)
+#endif  // RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
 RMW_INIT_MEMORY(init_options_impl)
 RMW_INIT_MEMORY(wait_set)
 RMW_INIT_MEMORY(guard_condition)
@@ -114,6 +139,7 @@ RMW_INIT_MEMORY(guard_condition)
 void rmw_uxrce_fini_session_memory(
   rmw_context_impl_t * session)
 {
+  rmw_uxrce_invalidate_wait_sets();
   put_memory(&session_memory, &session->mem);
 }
 
@@ -148,6 +174,24 @@ void rmw_uxrce_fini_publisher_memory(
   if (publisher->data) {
     rmw_uxrce_publisher_t * custom_publisher = (rmw_uxrce_publisher_t *)publisher->data;
 
+#if RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+    // Samples still waiting to be sent by this publisher are dropped
+    UXR_LOCK(&publisher_allocation_memory.mutex);
+    rmw_uxrce_mempool_item_t * item = publisher_allocation_memory.allocateditems;
+    while (NULL != item) {
+      rmw_uxrce_publisher_allocation_t * publisher_allocation =
+        (rmw_uxrce_publisher_allocation_t *)item->data;
+      UXR_LOCK(&publisher_allocation->mutex);
+      if (publisher_allocation->publisher == custom_publisher) {
+        publisher_allocation->pending = false;
+        publisher_allocation->publisher = NULL;
+      }
+      UXR_UNLOCK(&publisher_allocation->mutex);
+      item = item->next;
+    }
+    UXR_UNLOCK(&publisher_allocation_memory.mutex);
+#endif  // RMW_UXRCE_MAX_PUBLISHER_ALLOCATIONS > 0
+
     put_memory(&publisher_memory, &custom_publisher->mem);
     publisher->data = NULL;
   }
@@ -166,6 +210,9 @@ void rmw_uxrce_fini_subscription_memory(
   if (subscriber->data) {
     rmw_uxrce_subscription_t * custom_subscription = (rmw_uxrce_subscription_t *)subscriber->data;
 
+    rmw_uxrce_input_queue_clear(&custom_subscription->input_queue);
+    rmw_uxrce_invalidate_wait_sets();
+
     put_memory(&subscription_memory, &custom_subscription->mem);
     subscriber->data = NULL;
   }
@@ -184,6 +231,9 @@ void rmw_uxrce_fini_service_memory(
   if (service->data) {
     rmw_uxrce_service_t * custom_service = (rmw_uxrce_service_t *)service->data;
 
+    rmw_uxrce_input_queue_clear(&custom_service->input_queue);
+    rmw_uxrce_invalidate_wait_sets();
+
     put_memory(&service_memory, &custom_service->mem);
     service->data = NULL;
   }
@@ -202,6 +252,9 @@ void rmw_uxrce_fini_client_memory(
   if (client->data) {
     rmw_uxrce_client_t * custom_client = (rmw_uxrce_client_t *)client->data;
 
+    rmw_uxrce_input_queue_clear(&custom_client->input_queue);
+    rmw_uxrce_invalidate_wait_sets();
+
     put_memory(&client_memory, &custom_client->mem);
     client->data = NULL;
   }
@@ -209,6 +262,19 @@ void rmw_uxrce_fini_client_memory(
   client = NULL;
 }
 
+void rmw_uxrce_invalidate_wait_sets(void)
+{
+  UXR_LOCK(&wait_set_memory.mutex);
+
+  rmw_uxrce_mempool_item_t * item = wait_set_memory.allocateditems;
+  while (NULL != item) {
+    ((rmw_uxrce_wait_set_t *)item->data)->sessions_valid = false;
+    item = item->next;
+  }
+
+  UXR_UNLOCK(&wait_set_memory.mutex);
+}
+
 void rmw_uxrce_fini_topic_memory(
   rmw_uxrce_topic_t * topic)
 {
@@ -216,124 +282,291 @@ void rmw_uxrce_fini_topic_memory(
   topic->owner_node = NULL;
 }
 
-size_t rmw_uxrce_count_static_input_buffer_for_entity(
-  void * entity)
+// Samples accepted by rmw_uxrce_static_input_buffer_fit are copied into these storages
+// without further checks, so they must hold the sizes it compares with
+typedef char rmw_uxrce_static_input_buffer_size_check[
+  (sizeof(((rmw_uxrce_static_input_buffer_t *)0)->data) >=
+  RMW_UXRCE_STATIC_INPUT_BUFFER_SIZE) ? 1 : -1];
+#if RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+typedef char rmw_uxrce_large_input_buffer_size_check[
+  (sizeof(((rmw_uxrce_large_input_buffer_t *)0)->buffer) >=
+  RMW_UXRCE_MAX_INPUT_BUFFER_SIZE) ? 1 : -1];
+#endif  // RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+
+static void rmw_uxrce_static_input_buffer_release_large(
+  rmw_uxrce_static_input_buffer_t * static_buffer)
 {
-  size_t count = 0;
-
-  UXR_LOCK(&static_buffer_memory.mutex);
-  rmw_uxrce_mempool_item_t * item = static_buffer_memory.allocateditems;
+  if (NULL != static_buffer->user_buffer) {
+    UXR_LOCK(&static_buffer_memory.mutex);
+    static_buffer->user_buffer->in_use = false;
+    UXR_UNLOCK(&static_buffer_memory.mutex);
+    static_buffer->user_buffer = NULL;
+  }
 
-  while (item != NULL) {
-    rmw_uxrce_static_input_buffer_t * data = (rmw_uxrce_static_input_buffer_t *)item->data;
-    if (data->owner == entity) {
-      count++;
-    }
-    item = item->next;
+#if RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+  if (NULL != static_buffer->large_buffer) {
+    put_memory(&large_input_buffer_memory, &static_buffer->large_buffer->mem);
+    static_buffer->large_buffer = NULL;
   }
-  UXR_UNLOCK(&static_buffer_memory.mutex);
+#endif  // RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
 
-  return count;
+  static_buffer->buffer = static_buffer->data;
 }
 
-rmw_uxrce_mempool_item_t * rmw_uxrce_get_static_input_buffer_for_entity(
-  void * entity,
-  const rmw_qos_profile_t qos)
+void rmw_uxrce_put_static_input_buffer(
+  rmw_uxrce_static_input_buffer_t * static_buffer)
 {
-  rmw_uxrce_mempool_item_t * ret = NULL;
-
-  UXR_LOCK(&static_buffer_memory.mutex);
-  size_t count = rmw_uxrce_count_static_input_buffer_for_entity(entity);
-  switch (qos.history) {
-    case RMW_QOS_POLICY_HISTORY_UNKNOWN:
-    case RMW_QOS_POLICY_HISTORY_SYSTEM_DEFAULT:
-    case RMW_QOS_POLICY_HISTORY_KEEP_LAST:
-      if (qos.depth == 0 || count < qos.depth) {
-        ret = get_memory(&static_buffer_memory);
-      } else {
-        ret = rmw_uxrce_find_static_input_buffer_by_owner(entity);
-      }
-      break;
-    case RMW_QOS_POLICY_HISTORY_KEEP_ALL:
-      if (qos.depth == 0 || count < qos.depth) {
-        ret = get_memory(&static_buffer_memory);
-      } else {
-        // There aren't more slots for this entity
-      }
-      break;
-    default:
-      break;
+  rmw_uxrce_static_input_buffer_release_large(static_buffer);
+  static_buffer->queue_next = NULL;
+  put_memory(&static_buffer_memory, &static_buffer->mem);
+}
+
+bool rmw_uxrce_static_input_buffer_fit(
+  rmw_uxrce_static_input_buffer_t * static_buffer,
+  rmw_uxrce_user_input_buffer_t * user_buffer,
+  size_t length)
+{
+  if (length <= RMW_UXRCE_STATIC_INPUT_BUFFER_SIZE) {
+    return true;
+  }
+
+  // The user buffer of the entity holds a single large sample at a time. It is checked
+  // and claimed under the pool lock, as it is released along with its static buffer.
+  if (NULL != user_buffer) {
+    bool claimed = false;
+
+    UXR_LOCK(&static_buffer_memory.mutex);
+    if (NULL != user_buffer->data && !user_buffer->in_use && length <= user_buffer->size) {
+      user_buffer->in_use = true;
+      static_buffer->user_buffer = user_buffer;
+      static_buffer->buffer = user_buffer->data;
+      claimed = true;
+    }
+    UXR_UNLOCK(&static_buffer_memory.mutex);
+
+    if (claimed) {
+      return true;
+    }
+  }
+
+#if RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
+  if (length <= RMW_UXRCE_MAX_INPUT_BUFFER_SIZE) {
+    rmw_uxrce_mempool_item_t * item = get_memory(&large_input_buffer_memory);
+    if (NULL != item) {
+      static_buffer->large_buffer = (rmw_uxrce_large_input_buffer_t *)item->data;
+      static_buffer->buffer = static_buffer->large_buffer->buffer;
+      return true;
+    }
   }
-  UXR_UNLOCK(&static_buffer_memory.mutex);
+#endif  // RMW_UXRCE_MAX_LARGE_INPUT_BUFFERS > 0
 
-  return ret;
+  return false;
 }
 
-rmw_uxrce_mempool_item_t * rmw_uxrce_find_static_input_buffer_by_owner(
-  void * owner)
+// Entity input queue functions
+
+static bool rmw_uxrce_static_input_buffer_is_expired(
+  const rmw_uxrce_static_input_buffer_t * static_buffer,
+  const rmw_qos_profile_t * qos,
+  int64_t now_ns)
 {
-  rmw_uxrce_mempool_item_t * ret = NULL;
-  int64_t min_time = INT64_MAX;
+  rmw_time_t lifespan = qos->lifespan;
+  if (rmw_time_equal(lifespan, (rmw_time_t)RMW_DURATION_UNSPECIFIED)) {
+    lifespan = (rmw_time_t) RMW_UXRCE_QOS_LIFESPAN_DEFAULT;
+  }
 
-  UXR_LOCK(&static_buffer_memory.mutex);
+  int64_t expiration_time = static_buffer->timestamp + rmw_time_total_nsec(lifespan);
+  return expiration_time < now_ns || static_buffer->timestamp > now_ns;
+}
 
-  // Return the oldest
-  rmw_uxrce_mempool_item_t * static_buffer_item = static_buffer_memory.allocateditems;
-  while (static_buffer_item != NULL) {
-    rmw_uxrce_static_input_buffer_t * data =
-      (rmw_uxrce_static_input_buffer_t *)static_buffer_item->data;
+// Must be called with the queue locked
+static rmw_uxrce_static_input_buffer_t * rmw_uxrce_input_queue_unlink_head(
+  rmw_uxrce_input_queue_t * queue)
+{
+  rmw_uxrce_static_input_buffer_t * static_buffer = queue->head;
 
-    if (data->owner == owner && data->timestamp < min_time) {
-      ret = static_buffer_item;
-      min_time = data->timestamp;
+  if (NULL != static_buffer) {
+    queue->head = static_buffer->queue_next;
+    if (NULL == queue->head) {
+      queue->tail = NULL;
     }
-
-    static_buffer_item = static_buffer_item->next;
+    static_buffer->queue_next = NULL;
+    queue->count--;
   }
-  UXR_UNLOCK(&static_buffer_memory.mutex);
 
-  return ret;
+  return static_buffer;
 }
 
-void rmw_uxrce_clean_expired_static_input_buffer(void)
+void rmw_uxrce_init_input_queue(
+  rmw_uxrce_input_queue_t * queue)
 {
-  UXR_LOCK(&static_buffer_memory.mutex);
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+  // Entity slots are zero initialized and reused, so their mutex is only created once
+  if (!queue->mutex_initialized) {
+    UXR_INIT_LOCK(&queue->mutex);
+    queue->mutex_initialized = true;
+  }
+#endif  // UCLIENT_PROFILE_MULTITHREAD
 
-  rmw_uxrce_mempool_item_t * static_buffer_item = static_buffer_memory.allocateditems;
-  int64_t now_ns = rmw_uros_epoch_nanos();
+  queue->head = NULL;
+  queue->tail = NULL;
+  queue->count = 0;
+  queue->reserved = 0;
+}
 
-  while (static_buffer_item != NULL) {
-    rmw_uxrce_static_input_buffer_t * data =
-      (rmw_uxrce_static_input_buffer_t *)static_buffer_item->data;
-    rmw_time_t lifespan;
-    switch (data->entity_type) {
-      case RMW_UXRCE_ENTITY_TYPE_SUBSCRIPTION:
-        lifespan = ((rmw_uxrce_subscription_t *)data->owner)->qos.lifespan;
-        break;
-      case RMW_UXRCE_ENTITY_TYPE_CLIENT:
-        lifespan = ((rmw_uxrce_client_t *)data->owner)->qos.lifespan;
-        break;
-      case RMW_UXRCE_ENTITY_TYPE_SERVICE:
-        lifespan = ((rmw_uxrce_service_t *)data->owner)->qos.lifespan;
+// The depth check, the overwrite and the allocation are done under the queue lock, so the
+// buffers in the queue plus the reserved ones never exceed the depth. Every reserved buffer
+// must be either pushed or canceled.
+rmw_uxrce_static_input_buffer_t * rmw_uxrce_input_queue_reserve(
+  rmw_uxrce_input_queue_t * queue,
+  const rmw_qos_profile_t * qos,
+  bool * sample_lost)
+{
+  rmw_uxrce_static_input_buffer_t * static_buffer = NULL;
+  bool overwritten = false;
+
+  UXR_LOCK(&queue->mutex);
+  bool is_full = qos->depth != 0 && queue->count + queue->reserved >= qos->depth;
+
+  if (is_full) {
+    switch (qos->history) {
+      case RMW_QOS_POLICY_HISTORY_UNKNOWN:
+      case RMW_QOS_POLICY_HISTORY_SYSTEM_DEFAULT:
+      case RMW_QOS_POLICY_HISTORY_KEEP_LAST:
+        // Overwrite the oldest sample, it is pushed again as the newest one.
+        // Nothing is overwritten if every slot is reserved by other receptions.
+        static_buffer = rmw_uxrce_input_queue_unlink_head(queue);
+        overwritten = NULL != static_buffer;
+        if (overwritten) {
+          rmw_uxrce_static_input_buffer_release_large(static_buffer);
+        }
         break;
+      case RMW_QOS_POLICY_HISTORY_KEEP_ALL:
       default:
-        // Not recognized, clean this buffer as soon as possible
-        lifespan = (rmw_time_t) {0LL, 1LL};
+        // There aren't more slots for this entity
         break;
     }
-
-    if (rmw_time_equal(lifespan, (rmw_time_t)RMW_DURATION_UNSPECIFIED)) {
-      lifespan = (rmw_time_t) RMW_UXRCE_QOS_LIFESPAN_DEFAULT;
+  } else {
+    // Static buffer pool is locked after the queue, as everywhere else
+    rmw_uxrce_mempool_item_t * item = get_memory(&static_buffer_memory);
+    if (NULL != item) {
+      static_buffer = (rmw_uxrce_static_input_buffer_t *)item->data;
+      static_buffer->queue_next = NULL;
+      static_buffer->buffer = static_buffer->data;
     }
+  }
+
+  if (NULL != static_buffer) {
+    queue->reserved++;
+  }
+  UXR_UNLOCK(&queue->mutex);
 
-    rmw_uxrce_mempool_item_t * aux_next = static_buffer_item->next;
+  // Either a buffered sample is overwritten or the incoming one is dropped
+  if (NULL != sample_lost) {
+    *sample_lost = overwritten || NULL == static_buffer;
+  }
+
+  return static_buffer;
+}
 
-    int64_t expiration_time = data->timestamp + rmw_time_total_nsec(lifespan);
-    if (expiration_time < now_ns || data->timestamp > now_ns) {
-      put_memory(&static_buffer_memory, static_buffer_item);
+void rmw_uxrce_input_queue_push(
+  rmw_uxrce_input_queue_t * queue,
+  rmw_uxrce_static_input_buffer_t * static_buffer)
+{
+  static_buffer->queue_next = NULL;
+
+  UXR_LOCK(&queue->mutex);
+  if (NULL == queue->tail) {
+    queue->head = static_buffer;
+  } else {
+    queue->tail->queue_next = static_buffer;
+  }
+  queue->tail = static_buffer;
+  queue->count++;
+  queue->reserved--;
+  UXR_UNLOCK(&queue->mutex);
+}
+
+void rmw_uxrce_input_queue_cancel(
+  rmw_uxrce_input_queue_t * queue,
+  rmw_uxrce_static_input_buffer_t * static_buffer)
+{
+  UXR_LOCK(&queue->mutex);
+  queue->reserved--;
+  UXR_UNLOCK(&queue->mutex);
+
+  rmw_uxrce_put_static_input_buffer(static_buffer);
+}
+
+rmw_uxrce_static_input_buffer_t * rmw_uxrce_input_queue_pop(
+  rmw_uxrce_input_queue_t * queue,
+  const rmw_qos_profile_t * qos)
+{
+  rmw_uxrce_input_queue_clean_expired(queue, qos);
+
+  UXR_LOCK(&queue->mutex);
+  rmw_uxrce_static_input_buffer_t * static_buffer = rmw_uxrce_input_queue_unlink_head(queue);
+  UXR_UNLOCK(&queue->mutex);
+
+  return static_buffer;
+}
+
+void rmw_uxrce_input_queue_clean_expired(
+  rmw_uxrce_input_queue_t * queue,
+  const rmw_qos_profile_t * qos)
+{
+  rmw_uxrce_static_input_buffer_t * expired = NULL;
+  int64_t now_ns = rmw_uros_epoch_nanos();
+
+  UXR_LOCK(&queue->mutex);
+  rmw_uxrce_static_input_buffer_t * previous = NULL;
+  rmw_uxrce_static_input_buffer_t * static_buffer = queue->head;
+
+  while (static_buffer != NULL) {
+    rmw_uxrce_static_input_buffer_t * aux_next = static_buffer->queue_next;
+
+    if (rmw_uxrce_static_input_buffer_is_expired(static_buffer, qos, now_ns)) {
+      if (NULL == previous) {
+        queue->head = aux_next;
+      } else {
+        previous->queue_next = aux_next;
+      }
+      if (queue->tail == static_buffer) {
+        queue->tail = previous;
+      }
+      queue->count--;
+
+      static_buffer->queue_next = expired;
+      expired = static_buffer;
+    } else {
+      previous = static_buffer;
     }
 
-    static_buffer_item = aux_next;
+    static_buffer = aux_next;
+  }
+  UXR_UNLOCK(&queue->mutex);
+
+  // Return the buffers to the pool out of the queue lock
+  while (expired != NULL) {
+    rmw_uxrce_static_input_buffer_t * aux_next = expired->queue_next;
+    rmw_uxrce_put_static_input_buffer(expired);
+    expired = aux_next;
+  }
+}
+
+void rmw_uxrce_input_queue_clear(
+  rmw_uxrce_input_queue_t * queue)
+{
+  UXR_LOCK(&queue->mutex);
+  rmw_uxrce_static_input_buffer_t * static_buffer = queue->head;
+  queue->head = NULL;
+  queue->tail = NULL;
+  queue->count = 0;
+  UXR_UNLOCK(&queue->mutex);
+
+  while (static_buffer != NULL) {
+    rmw_uxrce_static_input_buffer_t * aux_next = static_buffer->queue_next;
+    rmw_uxrce_put_static_input_buffer(static_buffer);
+    static_buffer = aux_next;
   }
-  UXR_UNLOCK(&static_buffer_memory.mutex);
 }
@@ -15,6 +15,13 @@
 #include <rmw_microros_internal/utils.h>
 
 #include "./rmw_microros_internal/types.h"
+#include "./rmw_microros_internal/rmw_node.h"
+#include "./rmw_microros_internal/rmw_microxrcedds_topic.h"
+#include "./rmw_microros_internal/io_thread.h"
+#include "./rmw_microros_internal/rmw_publisher.h"
+#include "./rmw_microros_internal/rmw_subscription.h"
+#include "./rmw_microros_internal/rmw_client.h"
+#include "./rmw_microros_internal/rmw_service.h"
 #include "./rmw_microros_internal/error_handling_internal.h"
 
 // TODO(pablogs9) Refactor all this file.
@@ -36,10 +43,7 @@ bool run_xrce_session(
   } else {
     // This only handles one request at time
     uint8_t status;
-    if (!uxr_run_session_until_all_status(
-        &context->session,
-        timeout, &request, &status, 1))
-    {
+    if (!run_xrce_session_until_all_status(context, timeout, &request, &status, 1)) {
       RMW_UROS_TRACE_MESSAGE("Issues running micro XRCE-DDS session")
       return false;
     }
@@ -47,6 +51,543 @@ bool run_xrce_session(
   return true;
 }
 
+bool run_xrce_session_until_all_status(
+  rmw_context_impl_t * context,
+  int timeout,
+  const uint16_t * requests,
+  uint8_t * status,
+  size_t count)
+{
+#ifdef RMW_UXRCE_IO_THREAD
+  // The I/O thread may have received some replies before this call. They are taken
+  // from its mailbox while the session is held, so no reply is processed in between.
+  UXR_LOCK(&context->session.mutex);
+
+  uint16_t pending_requests[RMW_UXRCE_STREAM_HISTORY_OUTPUT];
+  uint8_t pending_status[RMW_UXRCE_STREAM_HISTORY_OUTPUT];
+  size_t pending_index[RMW_UXRCE_STREAM_HISTORY_OUTPUT];
+  size_t pending = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    if (!rmw_uxrce_io_thread_take_status(context, requests[i], &status[i])) {
+      pending_requests[pending] = requests[i];
+      pending_index[pending] = i;
+      pending++;
+    }
+
+    // Longer lists are waited in chunks
+    if (0 < pending && (RMW_UXRCE_STREAM_HISTORY_OUTPUT == pending || count == i + 1)) {
+      uxr_run_session_until_all_status(
+        &context->session, timeout, pending_requests, pending_status, pending);
+
+      // These replies were also kept in the mailbox while the session was spun here
+      for (size_t j = 0; j < pending; j++) {
+        status[pending_index[j]] = pending_status[j];
+        uint8_t mailbox_status;
+        rmw_uxrce_io_thread_take_status(context, pending_requests[j], &mailbox_status);
+      }
+      pending = 0;
+    }
+  }
+
+  UXR_UNLOCK(&context->session.mutex);
+
+  bool ret = true;
+  for (size_t i = 0; i < count; i++) {
+    ret &= UXR_STATUS_OK == status[i] || UXR_STATUS_OK_MATCHED == status[i];
+  }
+
+  return ret;
+#else
+  return uxr_run_session_until_all_status(&context->session, timeout, requests, status, count);
+#endif  // RMW_UXRCE_IO_THREAD
+}
+
+uxrStreamId get_priority_reliable_output(
+  rmw_context_impl_t * context,
+  uint8_t priority_class)
+{
+#if RMW_UXRCE_PRIORITY_CLASSES > 1
+  if (0 < priority_class) {
+    return context->priority_reliable_output[priority_class - 1];
+  }
+#else
+  (void)priority_class;
+#endif  // RMW_UXRCE_PRIORITY_CLASSES > 1
+  return context->reliable_output;
+}
+
+static uint32_t hash_xrce_entity(
+  uint32_t hash,
+  const uxrObjectId * object_id,
+  const char * name)
+{
+  // FNV-1a over object id, object type and entity name
+  const uint8_t id[3] = {
+    (uint8_t)(object_id->id >> 8), (uint8_t)object_id->id, object_id->type
+  };
+
+  for (size_t i = 0; i < sizeof(id); i++) {
+    hash = (hash ^ id[i]) * 16777619u;
+  }
+
+  for (const char * c = name; NULL != c && '\0' != *c; c++) {
+    hash = (hash ^ (uint8_t)*c) * 16777619u;
+  }
+
+  return hash;
+}
+
+static void update_session_store(
+  rmw_context_impl_t * context)
+{
+  if (rmw_uros_session_store_is_valid(context->session_store)) {
+    context->session_store->topology_hash = context->topology_hash;
+    context->session_store->entity_count = context->topology_entities;
+  }
+}
+
+bool run_xrce_creation(
+  rmw_context_impl_t * context,
+  const uxrObjectId * object_id,
+  const char * name,
+  uint16_t request)
+{
+  if (UXR_INVALID_REQUEST_ID == request) {
+    // Nothing was buffered, the pipelined requests are still verified
+    flush_xrce_creation(context);
+    return false;
+  }
+
+  context->topology_hash = hash_xrce_entity(context->topology_hash, object_id, name);
+  context->topology_entities++;
+
+  if (!context->resuming || context->creation_stream->type != UXR_RELIABLE_STREAM) {
+    if (!run_xrce_session(
+        context, context->creation_stream, request,
+        context->creation_timeout))
+    {
+      return false;
+    }
+    update_session_store(context);
+    return true;
+  }
+
+  // Warm restart: pipeline the request, its status is checked in batches
+  context->resume_requests[context->resume_requests_count++] = request;
+
+  bool ret = true;
+  if (context->resume_requests_count >= RMW_UXRCE_STREAM_HISTORY_OUTPUT ||
+    context->topology_entities >= context->session_store->entity_count)
+  {
+    ret = flush_xrce_creation(context);
+  }
+
+  return ret;
+}
+
+static bool confirm_xrce_creation(
+  rmw_context_impl_t * context,
+  uint16_t request)
+{
+  return UXR_INVALID_REQUEST_ID != request &&
+         run_xrce_session(context, context->creation_stream, request, context->creation_timeout);
+}
+
+// Creates again every entity of the context, waiting for each status. Creation requests
+// replace or reuse the Agent side entities, so the existing ones are kept.
+static bool recreate_xrce_graph(
+  rmw_context_impl_t * context)
+{
+  bool ret = true;
+  rmw_uxrce_mempool_item_t * item = NULL;
+
+  UXR_LOCK(&node_memory.mutex);
+  for (item = node_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_node_t * custom_node = (rmw_uxrce_node_t *)item->data;
+    if (context == custom_node->context && UXR_INVALID_ID != custom_node->participant_id.type) {
+      ret &= confirm_xrce_creation(context, buffer_participant_creation(custom_node));
+    }
+  }
+  UXR_UNLOCK(&node_memory.mutex);
+
+  UXR_LOCK(&topics_memory.mutex);
+  for (item = topics_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_topic_t * custom_topic = (rmw_uxrce_topic_t *)item->data;
+    if (context == custom_topic->owner_node->context &&
+      UXR_INVALID_ID != custom_topic->topic_id.type)
+    {
+      ret &= confirm_xrce_creation(context, buffer_topic_creation(custom_topic));
+    }
+  }
+  UXR_UNLOCK(&topics_memory.mutex);
+
+  UXR_LOCK(&publisher_memory.mutex);
+  for (item = publisher_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_publisher_t * custom_publisher = (rmw_uxrce_publisher_t *)item->data;
+    if (context != custom_publisher->owner_node->context) {
+      continue;
+    }
+    if (UXR_INVALID_ID != custom_publisher->publisher_id.type) {
+      ret &= confirm_xrce_creation(context, buffer_publisher_creation(custom_publisher));
+    }
+    if (UXR_INVALID_ID != custom_publisher->datawriter_id.type) {
+      ret &= confirm_xrce_creation(context, buffer_datawriter_creation(custom_publisher));
+    }
+  }
+  UXR_UNLOCK(&publisher_memory.mutex);
+
+  UXR_LOCK(&subscription_memory.mutex);
+  for (item = subscription_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_subscription_t * custom_subscription = (rmw_uxrce_subscription_t *)item->data;
+    if (context != custom_subscription->owner_node->context) {
+      continue;
+    }
+    if (UXR_INVALID_ID != custom_subscription->subscriber_id.type) {
+      ret &= confirm_xrce_creation(context, buffer_subscriber_creation(custom_subscription));
+    }
+    if (UXR_INVALID_ID != custom_subscription->datareader_id.type) {
+      ret &= confirm_xrce_creation(context, buffer_datareader_creation(custom_subscription));
+      buffer_subscription_data_request(custom_subscription);
+    }
+  }
+  UXR_UNLOCK(&subscription_memory.mutex);
+
+  UXR_LOCK(&client_memory.mutex);
+  for (item = client_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_client_t * custom_client = (rmw_uxrce_client_t *)item->data;
+    if (context == custom_client->owner_node->context &&
+      UXR_INVALID_ID != custom_client->client_id.type)
+    {
+      ret &= confirm_xrce_creation(context, buffer_requester_creation(custom_client));
+      custom_client->client_data_request = buffer_client_data_request(custom_client);
+    }
+  }
+  UXR_UNLOCK(&client_memory.mutex);
+
+  UXR_LOCK(&service_memory.mutex);
+  for (item = service_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_service_t * custom_service = (rmw_uxrce_service_t *)item->data;
+    if (context == custom_service->owner_node->context &&
+      UXR_INVALID_ID != custom_service->service_id.type)
+    {
+      ret &= confirm_xrce_creation(context, buffer_replier_creation(custom_service));
+      custom_service->service_data_resquest = buffer_service_data_request(custom_service);
+    }
+  }
+  UXR_UNLOCK(&service_memory.mutex);
+
+  if (!ret) {
+    RMW_UROS_TRACE_MESSAGE("Issues creating Micro XRCE-DDS entities")
+  }
+
+  return ret;
+}
+
+bool flush_xrce_creation(
+  rmw_context_impl_t * context)
+{
+  if (!context->resuming) {
+    return true;
+  }
+
+  // Pending statuses are removed by on_status, whoever spins the session
+  size_t pending = context->resume_requests_count;
+  if (0 < pending) {
+    uint16_t requests[RMW_UXRCE_STREAM_HISTORY_OUTPUT];
+    uint8_t status[RMW_UXRCE_STREAM_HISTORY_OUTPUT];
+    memcpy(requests, context->resume_requests, pending * sizeof(requests[0]));
+
+    run_xrce_session_until_all_status(
+      context, context->creation_timeout, requests, status, pending);
+  }
+
+  bool failed = 0 < context->resume_requests_count || context->resume_failed;
+  bool completed = context->topology_entities >= context->session_store->entity_count;
+
+  if (!failed && !completed) {
+    return true;
+  }
+
+  context->resuming = false;
+  context->resume_requests_count = 0;
+  context->resume_failed = false;
+
+  if (!failed && context->topology_hash == context->session_store->topology_hash) {
+    update_session_store(context);
+    return true;
+  }
+
+  // Handles already returned may refer to entities that are missing or differ on the Agent
+  RMW_UROS_TRACE_MESSAGE("Issues verifying Micro XRCE-DDS entities on warm restart")
+  if (!recreate_xrce_graph(context)) {
+    rmw_uros_session_store_invalidate(context->session_store);
+    return false;
+  }
+
+  update_session_store(context);
+  return true;
+}
+
+#define RMW_UXRCE_INIT_ID_POOL(context, kind) \
+  context->id_ ## kind.next_id = 0; \
+  context->id_ ## kind.free_ids = context->free_ ## kind ## _ids; \
+  context->id_ ## kind.capacity = \
+    sizeof(context->free_ ## kind ## _ids) / sizeof(context->free_ ## kind ## _ids[0]); \
+  context->id_ ## kind.free_head = 0; \
+  context->id_ ## kind.free_count = 0;
+
+void init_xrce_object_ids(
+  rmw_context_impl_t * context)
+{
+  RMW_UXRCE_INIT_ID_POOL(context, participant)
+  RMW_UXRCE_INIT_ID_POOL(context, topic)
+  RMW_UXRCE_INIT_ID_POOL(context, publisher)
+  RMW_UXRCE_INIT_ID_POOL(context, datawriter)
+  RMW_UXRCE_INIT_ID_POOL(context, subscriber)
+  RMW_UXRCE_INIT_ID_POOL(context, datareader)
+  RMW_UXRCE_INIT_ID_POOL(context, requester)
+  RMW_UXRCE_INIT_ID_POOL(context, replier)
+}
+
+static rmw_uxrce_id_pool_t * get_xrce_id_pool(
+  rmw_context_impl_t * context,
+  uint8_t type)
+{
+  switch (type) {
+    case UXR_PARTICIPANT_ID:
+      return &context->id_participant;
+    case UXR_TOPIC_ID:
+      return &context->id_topic;
+    case UXR_PUBLISHER_ID:
+      return &context->id_publisher;
+    case UXR_DATAWRITER_ID:
+      return &context->id_datawriter;
+    case UXR_SUBSCRIBER_ID:
+      return &context->id_subscriber;
+    case UXR_DATAREADER_ID:
+      return &context->id_datareader;
+    case UXR_REQUESTER_ID:
+      return &context->id_requester;
+    case UXR_REPLIER_ID:
+      return &context->id_replier;
+    default:
+      return NULL;
+  }
+}
+
+bool acquire_xrce_object_id(
+  rmw_context_impl_t * context,
+  uint8_t type,
+  uxrObjectId * object_id)
+{
+  // Failures leave an invalid id, so releasing it is a no-op
+  *object_id = uxr_object_id(0, UXR_INVALID_ID);
+
+  rmw_uxrce_id_pool_t * pool = get_xrce_id_pool(context, type);
+  if (NULL == pool) {
+    return false;
+  }
+
+  uint16_t id;
+  if (pool->free_count > 0) {
+    // Reuse the oldest released id, so late traffic of a deleted entity
+    // is unlikely to reach a new one
+    id = pool->free_ids[pool->free_head];
+    pool->free_head = (pool->free_head + 1) % pool->capacity;
+    pool->free_count--;
+  } else if (pool->next_id <= RMW_UXRCE_MAX_OBJECT_ID) {
+    id = pool->next_id++;
+  } else {
+    RMW_UROS_TRACE_MESSAGE("XRCE object id space exhausted")
+    return false;
+  }
+
+  *object_id = uxr_object_id(id, type);
+  return true;
+}
+
+void release_xrce_object_id(
+  rmw_context_impl_t * context,
+  const uxrObjectId * object_id)
+{
+  rmw_uxrce_id_pool_t * pool = get_xrce_id_pool(context, object_id->type);
+  if (NULL == pool) {
+    // Id not assigned
+    return;
+  }
+
+  // If the free list is full (dynamic pools grown above the static limits)
+  // the id is just dropped and never reused
+  if (pool->free_count < pool->capacity) {
+    pool->free_ids[(pool->free_head + pool->free_count) % pool->capacity] = object_id->id;
+    pool->free_count++;
+  }
+}
+
+bool run_xrce_deletion(
+  rmw_context_impl_t * context,
+  bool cancel_data,
+  const uxrObjectId * object_ids,
+  size_t count)
+{
+  if (context->session_teardown) {
+    // Entities are removed on the Agent along with the session, which is being deleted
+    return true;
+  }
+
+  bool ret = true;
+  size_t next = 0;
+
+  // Longer lists are sent in several batches, each one confirmed before the next
+  while (next < count) {
+    uint16_t requests[RMW_UXRCE_MAX_DELETION_BATCH];
+    uint8_t status[RMW_UXRCE_MAX_DELETION_BATCH];
+    size_t requests_count = 0;
+    size_t first_deletion = 0;
+
+    if (cancel_data && 0 == next) {
+      requests[requests_count++] = uxr_buffer_cancel_data(
+        &context->session, *context->destroy_stream, object_ids[0]);
+      first_deletion = requests_count;
+    }
+
+    const uxrObjectId * batch_ids = &object_ids[next];
+    while (next < count && requests_count < RMW_UXRCE_MAX_DELETION_BATCH) {
+      requests[requests_count++] = uxr_buffer_delete_entity(
+        &context->session, *context->destroy_stream, object_ids[next]);
+      next++;
+    }
+
+    if (context->destroy_stream->type == UXR_BEST_EFFORT_STREAM) {
+      uxr_flash_output_streams(&context->session);
+
+      // Never confirmed, the ids are reused once the deletions have been sent
+      for (size_t i = first_deletion; i < requests_count; i++) {
+        release_xrce_object_id(context, &batch_ids[i - first_deletion]);
+      }
+      continue;
+    }
+
+    // All the requests of a batch are confirmed at once, cancel data status is not checked
+    run_xrce_session_until_all_status(
+      context, context->destroy_timeout, requests, status, requests_count);
+
+    for (size_t i = first_deletion; i < requests_count; i++) {
+      // An id is only reused once the Agent no longer holds its entity, otherwise a
+      // late deletion could remove the entity that took it
+      if (UXR_STATUS_OK == status[i] || UXR_STATUS_ERR_UNKNOWN_REFERENCE == status[i]) {
+        release_xrce_object_id(context, &batch_ids[i - first_deletion]);
+      }
+      ret &= UXR_STATUS_OK == status[i];
+    }
+  }
+
+  if (!ret) {
+    RMW_UROS_TRACE_MESSAGE("Issues running micro XRCE-DDS session")
+  }
+
+  return ret;
+}
+
+typedef struct rmw_uxrce_deletion_batch_t
+{
+  rmw_context_impl_t * context;
+  uxrObjectId object_ids[RMW_UXRCE_MAX_DELETION_BATCH];
+  size_t count;
+  bool ret;
+} rmw_uxrce_deletion_batch_t;
+
+static void flush_deletion_batch(
+  rmw_uxrce_deletion_batch_t * batch)
+{
+  if (0 < batch->count) {
+    batch->ret &= run_xrce_deletion(batch->context, false, batch->object_ids, batch->count);
+    batch->count = 0;
+  }
+}
+
+static void add_deletion_batch(
+  rmw_uxrce_deletion_batch_t * batch,
+  const uxrObjectId * object_id)
+{
+  batch->object_ids[batch->count++] = *object_id;
+  if (RMW_UXRCE_MAX_DELETION_BATCH == batch->count) {
+    flush_deletion_batch(batch);
+  }
+}
+
+bool run_xrce_context_deletion(
+  rmw_context_impl_t * context)
+{
+  rmw_uxrce_deletion_batch_t batch;
+  batch.context = context;
+  batch.count = 0;
+  batch.ret = true;
+
+  // Batches are sent in order, so contained entities are deleted before their parents
+  rmw_uxrce_mempool_item_t * item;
+  for (item = publisher_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_publisher_t * custom_publisher = (rmw_uxrce_publisher_t *)item->data;
+    if (custom_publisher->owner_node->context == context) {
+      add_deletion_batch(&batch, &custom_publisher->datawriter_id);
+    }
+  }
+
+  for (item = subscription_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_subscription_t * custom_subscription = (rmw_uxrce_subscription_t *)item->data;
+    if (custom_subscription->owner_node->context == context) {
+      add_deletion_batch(&batch, &custom_subscription->datareader_id);
+    }
+  }
+
+  for (item = service_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_service_t * custom_service = (rmw_uxrce_service_t *)item->data;
+    if (custom_service->owner_node->context == context) {
+      add_deletion_batch(&batch, &custom_service->service_id);
+    }
+  }
+
+  for (item = client_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_client_t * custom_client = (rmw_uxrce_client_t *)item->data;
+    if (custom_client->owner_node->context == context) {
+      add_deletion_batch(&batch, &custom_client->client_id);
+    }
+  }
+
+  for (item = publisher_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_publisher_t * custom_publisher = (rmw_uxrce_publisher_t *)item->data;
+    if (custom_publisher->owner_node->context == context) {
+      add_deletion_batch(&batch, &custom_publisher->publisher_id);
+    }
+  }
+
+  for (item = subscription_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_subscription_t * custom_subscription = (rmw_uxrce_subscription_t *)item->data;
+    if (custom_subscription->owner_node->context == context) {
+      add_deletion_batch(&batch, &custom_subscription->subscriber_id);
+    }
+  }
+
+  for (item = topics_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_topic_t * custom_topic = (rmw_uxrce_topic_t *)item->data;
+    if (NULL != custom_topic->owner_node && custom_topic->owner_node->context == context) {
+      add_deletion_batch(&batch, &custom_topic->topic_id);
+    }
+  }
+
+  for (item = node_memory.allocateditems; NULL != item; item = item->next) {
+    rmw_uxrce_node_t * custom_node = (rmw_uxrce_node_t *)item->data;
+    if (custom_node->context == context) {
+      add_deletion_batch(&batch, &custom_node->participant_id);
+    }
+  }
+
+  flush_deletion_batch(&batch);
+
+  return batch.ret;
+}
+
 uxrQoS_t convert_qos_profile(const rmw_qos_profile_t * rmw_qos)
 {
   uxrQoSDurability durability;
@@ -138,12 +679,25 @@ bool generate_service_topics(
          (ret_rep < (int)buffer_size);
 }
 
+#if RMW_UXRCE_TYPE_NAME_CACHE_LENGTH > 0
+typedef struct rmw_uxrce_type_name_cache_t
+{
+  const message_type_support_callbacks_t * members;
+  size_t length;
+  char type_name[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
+} rmw_uxrce_type_name_cache_t;
+
+static rmw_uxrce_type_name_cache_t type_name_cache[RMW_UXRCE_TYPE_NAME_CACHE_LENGTH];
+static size_t type_name_cache_next = 0;
+#endif  // RMW_UXRCE_TYPE_NAME_CACHE_LENGTH > 0
+
 bool generate_service_types(
   const service_type_support_callbacks_t * members,
   char * request_type,
   char * reply_type,
   size_t buffer_size)
 {
+  // Resolving the members is cheap, the names are cached by generate_type_name
   const rosidl_message_type_support_t * req_members = members->request_members_();
   const rosidl_message_type_support_t * res_members = members->response_members_();
 
@@ -181,20 +735,15 @@ int build_service_xml(
     "</dds>";
 
   // Retrive request and response types
-  const rosidl_message_type_support_t * req_members = members->request_members_();
-  const rosidl_message_type_support_t * res_members = members->response_members_();
+  char req_type_name_buffer[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
+  char res_type_name_buffer[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
 
-  const message_type_support_callbacks_t * req_callbacks =
-    (const message_type_support_callbacks_t *)req_members->data;
-  const message_type_support_callbacks_t * res_callbacks =
-    (const message_type_support_callbacks_t *)res_members->data;
-
-
-  static char req_type_name_buffer[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
-  static char res_type_name_buffer[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
-
-  generate_type_name(req_callbacks, req_type_name_buffer, RMW_UXRCE_TYPE_NAME_MAX_LENGTH);
-  generate_type_name(res_callbacks, res_type_name_buffer, RMW_UXRCE_TYPE_NAME_MAX_LENGTH);
+  if (!generate_service_types(
+      members, req_type_name_buffer, res_type_name_buffer,
+      RMW_UXRCE_TYPE_NAME_MAX_LENGTH))
+  {
+    return 0;
+  }
 
   // Generate request and reply topic names
   char req_full_topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH + 1 + sizeof(ros_request_prefix) + 1 +
@@ -300,6 +849,22 @@ bool generate_type_name(
 
   type_name[0] = 0;
 
+#if RMW_UXRCE_TYPE_NAME_CACHE_LENGTH > 0
+  UXR_LOCK(&rmw_uxrce_name_cache_mutex);
+  for (size_t i = 0; i < RMW_UXRCE_TYPE_NAME_CACHE_LENGTH; i++) {
+    rmw_uxrce_type_name_cache_t * entry = &type_name_cache[i];
+    if (entry->members == members) {
+      bool fits = entry->length < buffer_size;
+      if (fits) {
+        memcpy(type_name, entry->type_name, entry->length + 1);
+      }
+      UXR_UNLOCK(&rmw_uxrce_name_cache_mutex);
+      return fits;
+    }
+  }
+  UXR_UNLOCK(&rmw_uxrce_name_cache_mutex);
+#endif  // RMW_UXRCE_TYPE_NAME_CACHE_LENGTH > 0
+
   int ret = snprintf(
     type_name, buffer_size,
     "%s%s%s%s%s%s%s",
@@ -312,7 +877,22 @@ bool generate_type_name(
     suffix
   );
 
-  return (ret >= 0) && (ret < (int)buffer_size);
+  bool success = (ret >= 0) && (ret < (int)buffer_size);
+
+#if RMW_UXRCE_TYPE_NAME_CACHE_LENGTH > 0
+  if (success && ret < RMW_UXRCE_TYPE_NAME_MAX_LENGTH) {
+    UXR_LOCK(&rmw_uxrce_name_cache_mutex);
+    rmw_uxrce_type_name_cache_t * entry = &type_name_cache[type_name_cache_next];
+    type_name_cache_next = (type_name_cache_next + 1) % RMW_UXRCE_TYPE_NAME_CACHE_LENGTH;
+
+    entry->members = members;
+    entry->length = (size_t)ret;
+    memcpy(entry->type_name, type_name, entry->length + 1);
+    UXR_UNLOCK(&rmw_uxrce_name_cache_mutex);
+  }
+#endif  // RMW_UXRCE_TYPE_NAME_CACHE_LENGTH > 0
+
+  return success;
 }
 
 bool generate_topic_name(
@@ -346,7 +926,7 @@ int build_topic_xml(
     "</dds>";
 
   int ret = 0;
-  static char type_name_buffer[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
+  char type_name_buffer[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
 
   if (RMW_UXRCE_TOPIC_NAME_MAX_LENGTH >= strlen(topic_name) &&
     generate_type_name(members, type_name_buffer, sizeof(type_name_buffer)))
@@ -385,7 +965,7 @@ int build_xml(
   size_t buffer_size)
 {
   int ret = 0;
-  static char type_name_buffer[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
+  char type_name_buffer[RMW_UXRCE_TYPE_NAME_MAX_LENGTH];
 
   if (generate_type_name(members, type_name_buffer, sizeof(type_name_buffer))) {
     char full_topic_name[RMW_UXRCE_TOPIC_NAME_MAX_LENGTH + 1 + sizeof(ros_topic_prefix)];
@@ -0,0 +1,176 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rmw_microros_internal/wakeup.h>
+
+#include <stddef.h>
+
+#ifdef RMW_UXRCE_WAIT_POLL
+#include <fcntl.h>
+#include <unistd.h>
+#endif  // RMW_UXRCE_WAIT_POLL
+
+#include "./rmw_microros_internal/io_thread.h"
+#include "./rmw_microros_internal/error_handling_internal.h"
+
+static rmw_uxrce_wakeup_callback_t wakeup_callback = NULL;
+static void * wakeup_args = NULL;
+
+#ifdef RMW_UXRCE_WAIT_POLL
+static bool set_nonblocking(
+  int fd)
+{
+  int flags = fcntl(fd, F_GETFL, 0);
+  return 0 <= flags &&
+         0 == fcntl(fd, F_SETFL, flags | O_NONBLOCK) &&
+         0 == fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+#endif  // RMW_UXRCE_WAIT_POLL
+
+bool rmw_uxrce_wakeup_init(
+  rmw_uxrce_wait_set_t * wait_set)
+{
+#ifdef RMW_UXRCE_WAIT_POLL
+  int fds[2];
+  if (0 != pipe(fds)) {
+    RMW_UROS_TRACE_MESSAGE("Cannot create rmw_wait wakeup pipe")
+    return false;
+  }
+
+  if (!set_nonblocking(fds[0]) || !set_nonblocking(fds[1])) {
+    RMW_UROS_TRACE_MESSAGE("Cannot configure rmw_wait wakeup pipe")
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+
+  // Signals walk the wait set pool, so the pipe is published under its lock
+  UXR_LOCK(&wait_set_memory.mutex);
+  wait_set->wakeup_pipe[0] = fds[0];
+  wait_set->wakeup_pipe[1] = fds[1];
+  UXR_UNLOCK(&wait_set_memory.mutex);
+#else
+  (void)wait_set;
+#endif  // RMW_UXRCE_WAIT_POLL
+
+  return true;
+}
+
+void rmw_uxrce_wakeup_fini(
+  rmw_uxrce_wait_set_t * wait_set)
+{
+#ifdef RMW_UXRCE_WAIT_POLL
+  UXR_LOCK(&wait_set_memory.mutex);
+
+  for (size_t i = 0; i < 2; i++) {
+    if (0 <= wait_set->wakeup_pipe[i]) {
+      close(wait_set->wakeup_pipe[i]);
+      wait_set->wakeup_pipe[i] = -1;
+    }
+  }
+
+  UXR_UNLOCK(&wait_set_memory.mutex);
+#else
+  (void)wait_set;
+#endif  // RMW_UXRCE_WAIT_POLL
+}
+
+void rmw_uxrce_wakeup_signal(void)
+{
+#ifdef RMW_UXRCE_WAIT_POLL
+  // Guard conditions are attached on each rmw_wait call, so every wait set is woken up
+  // and each one checks its own guard conditions
+  UXR_LOCK(&wait_set_memory.mutex);
+
+  rmw_uxrce_mempool_item_t * item = wait_set_memory.allocateditems;
+  while (NULL != item) {
+    rmw_uxrce_wait_set_t * wait_set = (rmw_uxrce_wait_set_t *)item->data;
+    if (0 <= wait_set->wakeup_pipe[1]) {
+      // If the pipe is full a wakeup is already pending
+      const uint8_t token = 0;
+      ssize_t ret = write(wait_set->wakeup_pipe[1], &token, sizeof(token));
+      (void)ret;
+    }
+    item = item->next;
+  }
+
+  UXR_UNLOCK(&wait_set_memory.mutex);
+#endif  // RMW_UXRCE_WAIT_POLL
+
+#ifdef RMW_UXRCE_IO_THREAD
+  rmw_uxrce_io_thread_notify_all();
+#endif  // RMW_UXRCE_IO_THREAD
+
+  // The callback is called out of the lock, so it may trigger the wakeup again
+  rmw_uxrce_wakeup_callback_t callback = NULL;
+  void * args = NULL;
+
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+  bool locked = rmw_uxrce_wakeup_callback_mutex_initialized;
+  if (locked) {
+    UXR_LOCK(&rmw_uxrce_wakeup_callback_mutex);
+  }
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+
+  callback = wakeup_callback;
+  args = wakeup_args;
+
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+  if (locked) {
+    UXR_UNLOCK(&rmw_uxrce_wakeup_callback_mutex);
+  }
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+
+  if (NULL != callback) {
+    callback(args);
+  }
+}
+
+void rmw_uxrce_wakeup_set_callback(
+  rmw_uxrce_wakeup_callback_t callback,
+  void * args)
+{
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+  // The lock is created by rmw_init, there is nothing to wake up before it
+  bool locked = rmw_uxrce_wakeup_callback_mutex_initialized;
+  if (locked) {
+    UXR_LOCK(&rmw_uxrce_wakeup_callback_mutex);
+  }
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+
+  wakeup_callback = callback;
+  wakeup_args = args;
+
+#ifdef UCLIENT_PROFILE_MULTITHREAD
+  if (locked) {
+    UXR_UNLOCK(&rmw_uxrce_wakeup_callback_mutex);
+  }
+#endif  // UCLIENT_PROFILE_MULTITHREAD
+}
+
+#ifdef RMW_UXRCE_WAIT_POLL
+int rmw_uxrce_wakeup_fd(
+  rmw_uxrce_wait_set_t * wait_set)
+{
+  return wait_set->wakeup_pipe[0];
+}
+
+void rmw_uxrce_wakeup_drain(
+  rmw_uxrce_wait_set_t * wait_set)
+{
+  uint8_t buffer[16];
+  while (0 < read(wait_set->wakeup_pipe[0], buffer, sizeof(buffer))) {
+  }
+}
+#endif  // RMW_UXRCE_WAIT_POLL
@@ -18,6 +18,16 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "rmw/rmw.h"
+
+#include "./test_utils.hpp"
+
+#include "rosidl_runtime_c/string.h"
+
 class RMWBaseTest : public ::testing::Test
 {
 protected:
@@ -45,4 +55,109 @@ protected:
   rmw_init_options_t test_options = rmw_get_zero_initialized_init_options();
 };
 
+// Node with a publisher and a subscription on the same dummy topic. Tests replacing the
+// dummy serialization callbacks override configure_typesupport.
+class RMWPubSubBaseTest : public RMWBaseTest
+{
+protected:
+  void SetUp() override
+  {
+    RMWBaseTest::SetUp();
+
+    ConfigureDummyTypeSupport(
+      topic_type,
+      topic_name,
+      message_namespace,
+      0,
+      &dummy_type_support);
+    configure_typesupport();
+
+    node = rmw_create_node(&test_context, "node", "/ns");
+    ASSERT_NE(node, nullptr);
+  }
+
+  void TearDown() override
+  {
+    if (nullptr != subscription) {
+      EXPECT_EQ(rmw_destroy_subscription(node, subscription), RMW_RET_OK);
+    }
+
+    if (nullptr != publisher) {
+      EXPECT_EQ(rmw_destroy_publisher(node, publisher), RMW_RET_OK);
+    }
+
+    EXPECT_EQ(rmw_destroy_node(node), RMW_RET_OK);
+
+    RMWBaseTest::TearDown();
+  }
+
+  virtual void configure_typesupport()
+  {
+  }
+
+  void create_publisher(const rmw_qos_profile_t & qos = rmw_qos_profile_default)
+  {
+    rmw_publisher_options_t default_publisher_options = rmw_get_default_publisher_options();
+    publisher = rmw_create_publisher(
+      node, &dummy_type_support.type_support, topic_name,
+      &qos, &default_publisher_options);
+    ASSERT_NE(publisher, nullptr);
+  }
+
+  void create_subscription(const rmw_qos_profile_t & qos = rmw_qos_profile_default)
+  {
+    rmw_subscription_options_t default_subscription_options =
+      rmw_get_default_subscription_options();
+    subscription = rmw_create_subscription(
+      node, &dummy_type_support.type_support, topic_name,
+      &qos, &default_subscription_options);
+    ASSERT_NE(subscription, nullptr);
+  }
+
+  // Gives the Agent time to match the entities created so far
+  void wait_for_matching()
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  // Default QoS publisher and subscription, matched before returning
+  void create_pubsub()
+  {
+    ASSERT_NO_FATAL_FAILURE(create_publisher());
+    ASSERT_NO_FATAL_FAILURE(create_subscription());
+    wait_for_matching();
+  }
+
+  // Only valid with the callbacks set by ConfigureStringTypeSupport
+  void publish_string(const std::string & data)
+  {
+    rosidl_runtime_c__String ros_message;
+    ros_message.data = const_cast<char *>(data.c_str());
+    ros_message.capacity = data.size();
+    ros_message.size = data.size();
+
+    EXPECT_EQ(rmw_publish(publisher, &ros_message, NULL), RMW_RET_OK);
+  }
+
+  rmw_ret_t wait_for_subscription(rmw_time_t wait_timeout)
+  {
+    void * subs[1] = {subscription->data};
+    rmw_subscriptions_t subscriptions;
+    subscriptions.subscribers = subs;
+    subscriptions.subscriber_count = 1;
+
+    return rmw_wait(&subscriptions, NULL, NULL, NULL, NULL, NULL, &wait_timeout);
+  }
+
+  const char * topic_type = "topic_type";
+  const char * topic_name = "topic_name";
+  const char * message_namespace = "package_name";
+
+  dummy_type_support_t dummy_type_support;
+
+  rmw_node_t * node = nullptr;
+  rmw_publisher_t * publisher = nullptr;
+  rmw_subscription_t * subscription = nullptr;
+};
+
 #endif  // RMW_BASE_TEST_HPP_
@@ -0,0 +1,195 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "rmw/error_handling.h"
+#include "rmw/event.h"
+#include "rmw/rmw.h"
+
+#include "./rmw_base_test.hpp"
+#include "./test_utils.hpp"
+
+#include "rosidl_runtime_c/string.h"
+
+class TestEvents : public RMWPubSubBaseTest
+{
+protected:
+  void configure_typesupport() override
+  {
+    ConfigureStringTypeSupport(&dummy_type_support);
+  }
+};
+
+TEST_F(TestEvents, unsupported_event_types)
+{
+  ASSERT_NO_FATAL_FAILURE(create_pubsub());
+
+  rmw_event_t event = rmw_get_zero_initialized_event();
+  EXPECT_EQ(
+    rmw_publisher_event_init(&event, publisher, RMW_EVENT_LIVELINESS_LOST),
+    RMW_RET_UNSUPPORTED);
+  rmw_reset_error();
+
+  EXPECT_EQ(
+    rmw_subscription_event_init(&event, subscription, RMW_EVENT_LIVELINESS_CHANGED),
+    RMW_RET_UNSUPPORTED);
+  rmw_reset_error();
+}
+
+TEST_F(TestEvents, message_lost_counts_overwritten_samples)
+{
+  ASSERT_NO_FATAL_FAILURE(create_publisher());
+
+  rmw_qos_profile_t qos = rmw_qos_profile_default;
+  qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+  qos.depth = 1;
+  ASSERT_NO_FATAL_FAILURE(create_subscription(qos));
+  wait_for_matching();
+
+  rmw_event_t event = rmw_get_zero_initialized_event();
+  ASSERT_EQ(
+    rmw_subscription_event_init(&event, subscription, RMW_EVENT_MESSAGE_LOST),
+    RMW_RET_OK);
+
+  const size_t sent_topics = 5;
+  for (size_t i = 0; i < sent_topics; i++) {
+    publish_string("hello_" + std::to_string(i));
+  }
+
+  for (size_t i = 0; i < sent_topics; i++) {
+    (void) !wait_for_subscription((rmw_time_t) {0LL, 100000000LL});
+  }
+
+  bool taken = false;
+  rmw_message_lost_status_t status;
+  ASSERT_EQ(rmw_take_event(&event, &status, &taken), RMW_RET_OK);
+  ASSERT_TRUE(taken);
+  EXPECT_EQ(status.total_count, sent_topics - qos.depth);
+  EXPECT_EQ(status.total_count_change, sent_topics - qos.depth);
+
+  // The change is reset once taken, the total is kept
+  taken = false;
+  ASSERT_EQ(rmw_take_event(&event, &status, &taken), RMW_RET_OK);
+  ASSERT_TRUE(taken);
+  EXPECT_EQ(status.total_count, sent_topics - qos.depth);
+  EXPECT_EQ(status.total_count_change, 0u);
+
+  // Only the newest sample is kept
+  char recv_data[100] = {0};
+  rosidl_runtime_c__String read_ros_message;
+  read_ros_message.data = recv_data;
+  read_ros_message.capacity = sizeof(recv_data);
+  read_ros_message.size = 0;
+
+  taken = false;
+  ASSERT_EQ(rmw_take(subscription, &read_ros_message, &taken, NULL), RMW_RET_OK);
+  ASSERT_TRUE(taken);
+  EXPECT_EQ(std::string(recv_data), "hello_" + std::to_string(sent_topics - 1));
+}
+
+TEST_F(TestEvents, message_lost_ignores_deserialization_errors)
+{
+  ASSERT_NO_FATAL_FAILURE(create_pubsub());
+
+  rmw_event_t event = rmw_get_zero_initialized_event();
+  ASSERT_EQ(
+    rmw_subscription_event_init(&event, subscription, RMW_EVENT_MESSAGE_LOST),
+    RMW_RET_OK);
+
+  publish_string("hello");
+  (void) !wait_for_subscription((rmw_time_t) {0LL, 100000000LL});
+
+  // The string does not fit in the message, the take fails but the sample was not lost
+  char recv_data[2] = {0};
+  rosidl_runtime_c__String read_ros_message;
+  read_ros_message.data = recv_data;
+  read_ros_message.capacity = sizeof(recv_data);
+  read_ros_message.size = 0;
+
+  bool taken = false;
+  EXPECT_EQ(rmw_take(subscription, &read_ros_message, &taken, NULL), RMW_RET_ERROR);
+  EXPECT_FALSE(taken);
+  rmw_reset_error();
+
+  rmw_message_lost_status_t status;
+  ASSERT_EQ(rmw_take_event(&event, &status, &taken), RMW_RET_OK);
+  ASSERT_TRUE(taken);
+  EXPECT_EQ(status.total_count, 0u);
+  EXPECT_EQ(status.total_count_change, 0u);
+}
+
+TEST_F(TestEvents, offered_deadline_missed)
+{
+  rmw_qos_profile_t qos = rmw_qos_profile_default;
+  qos.deadline = (rmw_time_t) {0LL, 100000000LL};
+  ASSERT_NO_FATAL_FAILURE(create_publisher(qos));
+  wait_for_matching();
+
+  rmw_event_t event = rmw_get_zero_initialized_event();
+  ASSERT_EQ(
+    rmw_publisher_event_init(&event, publisher, RMW_EVENT_OFFERED_DEADLINE_MISSED),
+    RMW_RET_OK);
+
+  publish_string("hello");
+  std::this_thread::sleep_for(std::chrono::milliseconds(350));
+
+  bool taken = false;
+  rmw_offered_deadline_missed_status_t status;
+  ASSERT_EQ(rmw_take_event(&event, &status, &taken), RMW_RET_OK);
+  ASSERT_TRUE(taken);
+  EXPECT_GE(status.total_count, 3);
+  EXPECT_EQ(status.total_count_change, status.total_count);
+
+  // Publishing restarts the deadline period
+  int32_t total_count = status.total_count;
+  publish_string("hello");
+
+  taken = false;
+  ASSERT_EQ(rmw_take_event(&event, &status, &taken), RMW_RET_OK);
+  ASSERT_TRUE(taken);
+  EXPECT_EQ(status.total_count, total_count);
+  EXPECT_EQ(status.total_count_change, 0);
+}
+
+TEST_F(TestEvents, requested_deadline_missed)
+{
+  rmw_qos_profile_t qos = rmw_qos_profile_default;
+  qos.deadline = (rmw_time_t) {0LL, 100000000LL};
+  ASSERT_NO_FATAL_FAILURE(create_subscription(qos));
+  wait_for_matching();
+
+  rmw_event_t event = rmw_get_zero_initialized_event();
+  ASSERT_EQ(
+    rmw_subscription_event_init(&event, subscription, RMW_EVENT_REQUESTED_DEADLINE_MISSED),
+    RMW_RET_OK);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+  bool taken = false;
+  rmw_requested_deadline_missed_status_t status;
+  ASSERT_EQ(rmw_take_event(&event, &status, &taken), RMW_RET_OK);
+  ASSERT_TRUE(taken);
+  EXPECT_GE(status.total_count, 2);
+  EXPECT_EQ(status.total_count_change, status.total_count);
+
+  taken = false;
+  int32_t total_count = status.total_count;
+  ASSERT_EQ(rmw_take_event(&event, &status, &taken), RMW_RET_OK);
+  ASSERT_TRUE(taken);
+  EXPECT_GE(status.total_count, total_count);
+  EXPECT_EQ(status.total_count_change, status.total_count - total_count);
+}
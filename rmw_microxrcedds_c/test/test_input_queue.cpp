@@ -0,0 +1,126 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+
+#include "rmw/rmw.h"
+
+#include "./rmw_base_test.hpp"
+#include "./rmw_microros_internal/types.h"
+
+class TestInputQueue : public RMWBaseTest
+{
+protected:
+  void SetUp() override
+  {
+    RMWBaseTest::SetUp();
+
+    memset(&queue, 0, sizeof(queue));
+    rmw_uxrce_init_input_queue(&queue);
+
+    qos = rmw_qos_profile_default;
+    qos.depth = 2;
+  }
+
+  void TearDown() override
+  {
+    rmw_uxrce_input_queue_clear(&queue);
+
+    RMWBaseTest::TearDown();
+  }
+
+  // Stores a sample holding a single byte, returns whether another sample was lost
+  bool push(
+    uint8_t value)
+  {
+    bool sample_lost = false;
+    rmw_uxrce_static_input_buffer_t * static_buffer =
+      rmw_uxrce_input_queue_reserve(&queue, &qos, &sample_lost);
+    EXPECT_NE(static_buffer, nullptr);
+
+    if (nullptr != static_buffer) {
+      static_buffer->buffer[0] = value;
+      static_buffer->length = 1;
+      static_buffer->timestamp = rmw_uros_epoch_nanos();
+      rmw_uxrce_input_queue_push(&queue, static_buffer);
+    }
+
+    return sample_lost;
+  }
+
+  // Takes the oldest sample and returns its byte, or -1 if the queue is empty
+  int pop()
+  {
+    rmw_uxrce_static_input_buffer_t * static_buffer =
+      rmw_uxrce_input_queue_pop(&queue, &qos);
+    if (nullptr == static_buffer) {
+      return -1;
+    }
+
+    int value = static_buffer->buffer[0];
+    rmw_uxrce_put_static_input_buffer(static_buffer);
+    return value;
+  }
+
+  rmw_uxrce_input_queue_t queue;
+  rmw_qos_profile_t qos;
+};
+
+TEST_F(TestInputQueue, keep_last_overwrites_oldest)
+{
+  qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+
+  EXPECT_FALSE(push(1));
+  EXPECT_FALSE(push(2));
+  EXPECT_TRUE(push(3));
+  EXPECT_TRUE(push(4));
+  EXPECT_EQ(queue.count, 2u);
+
+  EXPECT_EQ(pop(), 3);
+  EXPECT_EQ(pop(), 4);
+  EXPECT_EQ(pop(), -1);
+  EXPECT_EQ(queue.count, 0u);
+}
+
+TEST_F(TestInputQueue, keep_last_keeps_order_after_take)
+{
+  qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+
+  EXPECT_FALSE(push(1));
+  EXPECT_FALSE(push(2));
+  EXPECT_EQ(pop(), 1);
+
+  EXPECT_FALSE(push(3));
+  EXPECT_TRUE(push(4));
+
+  EXPECT_EQ(pop(), 3);
+  EXPECT_EQ(pop(), 4);
+  EXPECT_EQ(pop(), -1);
+}
+
+TEST_F(TestInputQueue, keep_all_drops_incoming)
+{
+  qos.history = RMW_QOS_POLICY_HISTORY_KEEP_ALL;
+
+  EXPECT_FALSE(push(1));
+  EXPECT_FALSE(push(2));
+
+  bool sample_lost = false;
+  EXPECT_EQ(rmw_uxrce_input_queue_reserve(&queue, &qos, &sample_lost), nullptr);
+  EXPECT_TRUE(sample_lost);
+
+  EXPECT_EQ(pop(), 1);
+  EXPECT_EQ(pop(), 2);
+  EXPECT_EQ(pop(), -1);
+}
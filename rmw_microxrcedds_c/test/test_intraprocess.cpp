@@ -0,0 +1,96 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+#include "rmw_microros/rmw_microros.h"
+
+#include "./rmw_base_test.hpp"
+#include "./test_utils.hpp"
+
+#include "rosidl_runtime_c/string.h"
+
+class TestIntraprocess : public RMWPubSubBaseTest
+{
+protected:
+  void SetUp() override
+  {
+    RMWPubSubBaseTest::SetUp();
+
+    ASSERT_NO_FATAL_FAILURE(create_pubsub());
+  }
+
+  void configure_typesupport() override
+  {
+    ConfigureStringTypeSupport(&dummy_type_support);
+  }
+
+  // Waits and takes for a while, returns how many samples were taken
+  size_t receive(const std::string & expected)
+  {
+    size_t received = 0;
+
+    // Keep waiting after the first sample so that a duplicate would also arrive
+    for (size_t i = 0; i < 5; i++) {
+      (void) !wait_for_subscription((rmw_time_t) {0LL, 200000000LL});
+
+      char recv_data[100] = {0};
+      rosidl_runtime_c__String read_ros_message;
+      read_ros_message.data = recv_data;
+      read_ros_message.capacity = sizeof(recv_data);
+      read_ros_message.size = 0;
+
+      bool taken = false;
+      while (RMW_RET_OK == rmw_take(subscription, &read_ros_message, &taken, NULL) && taken) {
+        EXPECT_EQ(std::string(recv_data), expected);
+        received++;
+        taken = false;
+      }
+      rmw_reset_error();
+    }
+
+    return received;
+  }
+};
+
+TEST_F(TestIntraprocess, received_once_through_agent)
+{
+  publish_string("hello");
+
+  EXPECT_EQ(receive("hello"), 1u);
+}
+
+#ifdef RMW_UXRCE_INTRAPROCESS
+TEST_F(TestIntraprocess, local_only_received_once)
+{
+  ASSERT_EQ(rmw_uros_set_publisher_local_only(publisher, true), RMW_RET_OK);
+
+  publish_string("hello");
+
+  // The sample is not forwarded to the Agent, so it does not come back a second time
+  EXPECT_EQ(receive("hello"), 1u);
+}
+
+TEST_F(TestIntraprocess, local_only_can_be_disabled)
+{
+  ASSERT_EQ(rmw_uros_set_publisher_local_only(publisher, true), RMW_RET_OK);
+  ASSERT_EQ(rmw_uros_set_publisher_local_only(publisher, false), RMW_RET_OK);
+
+  publish_string("hello");
+
+  EXPECT_EQ(receive("hello"), 1u);
+}
+#endif  // RMW_UXRCE_INTRAPROCESS
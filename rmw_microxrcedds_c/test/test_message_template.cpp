@@ -0,0 +1,144 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+#include "rmw_microros/rmw_microros.h"
+
+#include "./rmw_base_test.hpp"
+#include "./test_utils.hpp"
+
+typedef struct
+{
+  uint32_t counter;
+  uint8_t flag;
+  double value;
+} template_message_t;
+
+class TestMessageTemplate : public RMWPubSubBaseTest
+{
+protected:
+  void SetUp() override
+  {
+    RMWPubSubBaseTest::SetUp();
+
+    ASSERT_NO_FATAL_FAILURE(create_pubsub());
+  }
+
+  void configure_typesupport() override
+  {
+    dummy_type_support.callbacks.cdr_serialize =
+      [](const void * untyped_ros_message, ucdrBuffer * cdr) -> bool {
+        const template_message_t * ros_message =
+          reinterpret_cast<const template_message_t *>(untyped_ros_message);
+
+        bool ret = ucdr_serialize_uint32_t(cdr, ros_message->counter);
+        ret &= ucdr_serialize_uint8_t(cdr, ros_message->flag);
+        ret &= ucdr_serialize_double(cdr, ros_message->value);
+        return ret;
+      };
+
+    dummy_type_support.callbacks.cdr_deserialize =
+      [](ucdrBuffer * cdr, void * untyped_ros_message) -> bool {
+        template_message_t * ros_message =
+          reinterpret_cast<template_message_t *>(untyped_ros_message);
+
+        bool ret = ucdr_deserialize_uint32_t(cdr, &ros_message->counter);
+        ret &= ucdr_deserialize_uint8_t(cdr, &ros_message->flag);
+        ret &= ucdr_deserialize_double(cdr, &ros_message->value);
+        return ret;
+      };
+
+    dummy_type_support.callbacks.get_serialized_size =
+      [](const void *) -> uint32_t {
+        size_t size = 0;
+        size += ucdr_alignment(size, sizeof(uint32_t)) + sizeof(uint32_t);
+        size += sizeof(uint8_t);
+        size += ucdr_alignment(size, sizeof(double)) + sizeof(double);
+        return static_cast<uint32_t>(size);
+      };
+
+    dummy_type_support.callbacks.max_serialized_size =
+      []() -> size_t {
+        return 0;
+      };
+  }
+
+  template_message_t take_message()
+  {
+    EXPECT_EQ(wait_for_subscription((rmw_time_t) {2LL, 0LL}), RMW_RET_OK);
+
+    template_message_t ros_message = {0, 0, 0.0};
+    bool taken = false;
+    EXPECT_EQ(rmw_take(subscription, &ros_message, &taken, NULL), RMW_RET_OK);
+    EXPECT_TRUE(taken);
+
+    return ros_message;
+  }
+};
+
+TEST_F(TestMessageTemplate, buffer_too_small)
+{
+  template_message_t ros_message = {1, 7, 0.5};
+  uint8_t buffer[16];
+
+  rmw_uros_message_template_t message_template;
+  EXPECT_EQ(
+    rmw_uros_init_message_template(
+      &message_template, publisher, &ros_message, buffer, sizeof(buffer)),
+    RMW_RET_ERROR);
+  rmw_reset_error();
+}
+
+TEST_F(TestMessageTemplate, publish_patched_fields)
+{
+  template_message_t ros_message = {1, 7, 0.5};
+  uint8_t buffer[64];
+
+  rmw_uros_message_template_t message_template;
+  ASSERT_EQ(
+    rmw_uros_init_message_template(
+      &message_template, publisher, &ros_message, buffer, sizeof(buffer)),
+    RMW_RET_OK);
+  ASSERT_EQ(
+    rmw_uros_message_template_add_field(
+      &message_template, &ros_message, &ros_message.counter, sizeof(ros_message.counter)),
+    RMW_RET_OK);
+  ASSERT_EQ(
+    rmw_uros_message_template_add_field(
+      &message_template, &ros_message, &ros_message.value, sizeof(ros_message.value)),
+    RMW_RET_OK);
+
+  // Adding the fields leaves the message untouched
+  EXPECT_EQ(ros_message.counter, 1u);
+  EXPECT_EQ(ros_message.flag, 7u);
+  EXPECT_EQ(ros_message.value, 0.5);
+
+  // Only the added fields are copied, the flag keeps the value of the template
+  template_message_t patch = {42, 9, 2.25};
+  ASSERT_EQ(rmw_uros_publish_message_template(&message_template, &patch), RMW_RET_OK);
+
+  template_message_t received = take_message();
+  EXPECT_EQ(received.counter, 42u);
+  EXPECT_EQ(received.flag, 7u);
+  EXPECT_EQ(received.value, 2.25);
+
+  // Fields are patched in place, so the template keeps the last published values
+  ASSERT_EQ(rmw_uros_publish_message_template(&message_template, NULL), RMW_RET_OK);
+
+  received = take_message();
+  EXPECT_EQ(received.counter, 42u);
+  EXPECT_EQ(received.flag, 7u);
+  EXPECT_EQ(received.value, 2.25);
+}
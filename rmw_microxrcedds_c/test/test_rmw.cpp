@@ -21,6 +21,8 @@
 
 #include <ctime>
 
+#include "./rmw_microros_internal/types.h"
+
 /*
  * Testing rmw init and shutdown. htps://github.com/microROS/rmw-microxrcedds/issues/14
  */
@@ -92,3 +94,62 @@ TEST(rmw_microxrcedds, sync_session)
   ASSERT_EQ(rmw_init_options_fini(&test_options), RMW_RET_OK);
   ASSERT_EQ(rmw_shutdown(&test_context), RMW_RET_OK);
 }
+
+/*
+ * Testing rmw warm restart session store.
+ */
+TEST(rmw_microxrcedds, warm_restart)
+{
+  rmw_uros_session_store_t store = {};
+  rmw_uros_session_store_t stored_state = {};
+
+  for (size_t i = 0; i < 2; i++) {
+    rmw_context_t test_context = rmw_get_zero_initialized_context();
+    rmw_init_options_t test_options = rmw_get_zero_initialized_init_options();
+
+    ASSERT_EQ(rmw_init_options_init(&test_options, rcutils_get_default_allocator()), RMW_RET_OK);
+    ASSERT_EQ(rmw_uros_options_set_session_store(&store, &test_options), RMW_RET_OK);
+    ASSERT_EQ(rmw_init(&test_options, &test_context), RMW_RET_OK);
+    ASSERT_TRUE(rmw_uros_session_store_is_valid(&store));
+
+    // Only the second run finds a stored topology to resume
+    ASSERT_EQ(test_context.impl->resuming, 1u == i);
+    if (1u == i) {
+      ASSERT_EQ(store.client_key, stored_state.client_key);
+    }
+
+    rmw_node_t * node = rmw_create_node(&test_context, "warm_restart_node", "/ns");
+    ASSERT_NE(node, nullptr);
+    ASSERT_EQ(store.entity_count, 1u);
+    ASSERT_FALSE(test_context.impl->resuming);
+
+    if (1u == i) {
+      // The resumed topology matched the stored one
+      ASSERT_EQ(store.topology_hash, stored_state.topology_hash);
+    }
+
+    // Keep the state as a reboot would, shutting down invalidates the store
+    stored_state = store;
+
+    ASSERT_EQ(rmw_destroy_node(node), RMW_RET_OK);
+    ASSERT_EQ(rmw_init_options_fini(&test_options), RMW_RET_OK);
+    ASSERT_EQ(rmw_shutdown(&test_context), RMW_RET_OK);
+    ASSERT_FALSE(rmw_uros_session_store_is_valid(&store));
+
+    store = stored_state;
+  }
+}
+
+/*
+ * Testing rmw warm restart session store with uninitialized options.
+ */
+TEST(rmw_microxrcedds, warm_restart_invalid_options)
+{
+  rmw_uros_session_store_t store = {};
+  rmw_init_options_t test_options = rmw_get_zero_initialized_init_options();
+
+  ASSERT_EQ(
+    rmw_uros_options_set_session_store(&store, &test_options),
+    RMW_RET_INVALID_ARGUMENT);
+  ASSERT_EQ(rmw_uros_options_set_session_store(&store, nullptr), RMW_RET_INVALID_ARGUMENT);
+}
@@ -15,8 +15,10 @@
 
 #include <test_utils.hpp>
 
+#include <cstring>
 #include <string>
 
+#include "rosidl_runtime_c/string.h"
 #include "rosidl_typesupport_microxrcedds_c/identifier.h"
 
 void ConfigureDummyTypeSupport(
@@ -62,6 +64,41 @@ void ConfigureDummyTypeSupport(
     };
 }
 
+void ConfigureStringTypeSupport(
+  dummy_type_support_t * dummy_type_support)
+{
+  dummy_type_support->callbacks.cdr_serialize =
+    [](const void * untyped_ros_message, ucdrBuffer * cdr)
+    {
+      const rosidl_runtime_c__String * ros_message =
+        reinterpret_cast<const rosidl_runtime_c__String *>(untyped_ros_message);
+      return ucdr_serialize_string(cdr, ros_message->data);
+    };
+  dummy_type_support->callbacks.cdr_deserialize =
+    [](ucdrBuffer * cdr, void * untyped_ros_message)
+    {
+      rosidl_runtime_c__String * ros_message =
+        reinterpret_cast<rosidl_runtime_c__String *>(untyped_ros_message);
+      bool ret = ucdr_deserialize_string(cdr, ros_message->data, ros_message->capacity);
+      if (ret) {
+        ros_message->size = strlen(ros_message->data);
+      }
+      return ret;
+    };
+  dummy_type_support->callbacks.get_serialized_size = [](const void * untyped_ros_message)
+    {
+      const rosidl_runtime_c__String * ros_message =
+        reinterpret_cast<const rosidl_runtime_c__String *>(untyped_ros_message);
+
+      // Length prefix followed by the characters and the null terminator
+      return uint32_t(sizeof(uint32_t) + ros_message->size + 1);
+    };
+  dummy_type_support->callbacks.max_serialized_size = []()
+    {
+      return size_t(0u);
+    };
+}
+
 void ConfigureDummyServiceTypeSupport(
   const char * type_name,
   const char * service_name,
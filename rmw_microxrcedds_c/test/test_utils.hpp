@@ -53,6 +53,10 @@ void ConfigureDummyTypeSupport(
   size_t id,
   dummy_type_support_t * dummy_type_support);
 
+// Replaces the dummy callbacks with ones handling a rosidl_runtime_c__String message
+void ConfigureStringTypeSupport(
+  dummy_type_support_t * dummy_type_support);
+
 void ConfigureDummyServiceTypeSupport(
   const char * type_name,
   const char * service_name,
@@ -0,0 +1,117 @@
+// Copyright 2023 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <thread>
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+
+#include "./rmw_base_test.hpp"
+#include "./test_utils.hpp"
+
+class TestWakeup : public RMWPubSubBaseTest
+{
+protected:
+  void SetUp() override
+  {
+    RMWPubSubBaseTest::SetUp();
+
+    // The subscription adds a session to the wait, so rmw_wait blocks on its transport
+    ASSERT_NO_FATAL_FAILURE(create_subscription());
+
+    guard_condition = rmw_create_guard_condition(&test_context);
+    ASSERT_NE(guard_condition, nullptr);
+
+    foreign_guard_condition = rmw_create_guard_condition(&test_context);
+    ASSERT_NE(foreign_guard_condition, nullptr);
+
+    wait_set = rmw_create_wait_set(&test_context, 2);
+    ASSERT_NE(wait_set, nullptr);
+  }
+
+  void TearDown() override
+  {
+    EXPECT_EQ(rmw_destroy_wait_set(wait_set), RMW_RET_OK);
+    EXPECT_EQ(rmw_destroy_guard_condition(foreign_guard_condition), RMW_RET_OK);
+    EXPECT_EQ(rmw_destroy_guard_condition(guard_condition), RMW_RET_OK);
+
+    RMWPubSubBaseTest::TearDown();
+  }
+
+  // Waits on the subscription and the guard condition, returns the elapsed milliseconds
+  int64_t wait(
+    rmw_ret_t expected,
+    rmw_time_t wait_timeout)
+  {
+    void * subs[1] = {subscription->data};
+    rmw_subscriptions_t subscriptions;
+    subscriptions.subscribers = subs;
+    subscriptions.subscriber_count = 1;
+
+    void * gcs[1] = {guard_condition->data};
+    rmw_guard_conditions_t guard_conditions;
+    guard_conditions.guard_conditions = gcs;
+    guard_conditions.guard_condition_count = 1;
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(
+      rmw_wait(&subscriptions, &guard_conditions, NULL, NULL, NULL, wait_set, &wait_timeout),
+      expected);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(subscriptions.subscribers[0], nullptr);
+    EXPECT_EQ(guard_conditions.guard_conditions[0] != nullptr, RMW_RET_OK == expected);
+
+    return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+  }
+
+  rmw_guard_condition_t * guard_condition = nullptr;
+  rmw_guard_condition_t * foreign_guard_condition = nullptr;
+  rmw_wait_set_t * wait_set = nullptr;
+};
+
+TEST_F(TestWakeup, trigger_before_wait)
+{
+  ASSERT_EQ(rmw_trigger_guard_condition(guard_condition), RMW_RET_OK);
+
+  EXPECT_LT(wait(RMW_RET_OK, (rmw_time_t) {5LL, 0LL}), 1000);
+}
+
+TEST_F(TestWakeup, trigger_wakes_up_blocked_wait)
+{
+  std::thread trigger([this]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+      EXPECT_EQ(rmw_trigger_guard_condition(guard_condition), RMW_RET_OK);
+    });
+
+  int64_t elapsed = wait(RMW_RET_OK, (rmw_time_t) {5LL, 0LL});
+  trigger.join();
+
+  EXPECT_GE(elapsed, 150);
+  EXPECT_LT(elapsed, 2000);
+}
+
+TEST_F(TestWakeup, foreign_trigger_does_not_end_wait)
+{
+  std::thread trigger([this]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+      EXPECT_EQ(rmw_trigger_guard_condition(foreign_guard_condition), RMW_RET_OK);
+    });
+
+  int64_t elapsed = wait(RMW_RET_TIMEOUT, (rmw_time_t) {1LL, 0LL});
+  trigger.join();
+
+  EXPECT_GE(elapsed, 900);
+}